@@ -0,0 +1,223 @@
+#include "BoardGenerator.h"
+
+#include "structs/board/TilePosition.h"
+#include "math/RandomGenerator.h"
+
+#include <cmath>
+#include <vector>
+#include <sstream>
+#include <numeric>
+#include <iostream>
+#include <algorithm>
+#include <type_traits>
+
+namespace
+{
+	// Not a std::string, so nothing has to be constructed before main
+	const char generatorPrefix[] = "generate:";
+	const size_t generatorPrefixLength = sizeof( generatorPrefix ) - 1;
+
+	// Same spacing as the hand written boards, a 60 x 20 tile and 5 pixels between them
+	const double stepX = 65.0;
+	const double stepY = 25.0;
+
+	template < class T >
+	bool ReadValue( const std::string &text, T &value )
+	{
+		// The stream wraps "-5" around for unsigned types instead of failing
+		if ( std::is_unsigned< T >::value && text.find( '-' ) != std::string::npos )
+			return false;
+
+		std::istringstream ss( text );
+		ss >> value;
+
+		return !ss.fail() && ss.eof();
+	}
+	uint32_t NextBelow( RandomGenerator &random, uint32_t max )
+	{
+		return std::min( static_cast< uint32_t > ( random.NextDouble() * max ), max - 1 );
+	}
+}
+
+bool BoardGenerator::IsGeneratorName( const std::string &name )
+{
+	return name.compare( 0, generatorPrefixLength, generatorPrefix ) == 0;
+}
+bool BoardGenerator::ParseName( const std::string &name, BoardGeneratorSettings &settings )
+{
+	if ( !IsGeneratorName( name ) )
+		return false;
+
+	std::istringstream ss( name.substr( generatorPrefixLength ) );
+	std::string setting;
+
+	while ( std::getline( ss, setting, ',' ) )
+	{
+		if ( setting.empty() )
+			continue;
+
+		size_t split = setting.find( '=' );
+		std::string key = setting.substr( 0, split );
+		std::string value = ( split == std::string::npos ) ? "" : setting.substr( split + 1 );
+
+		bool isValid = false;
+
+		if ( key == "tiles" )
+			isValid = ReadValue( value, settings.tileCount );
+		else if ( key == "density" )
+			isValid = ReadValue( value, settings.density ) && settings.density > 0.0 && settings.density <= 1.0;
+		else if ( key == "regular" )
+			isValid = ReadValue( value, settings.regular ) && settings.regular >= 0.0;
+		else if ( key == "explosive" )
+			isValid = ReadValue( value, settings.explosive ) && settings.explosive >= 0.0;
+		else if ( key == "hard" )
+			isValid = ReadValue( value, settings.hard ) && settings.hard >= 0.0;
+		else if ( key == "unbreakable" )
+			isValid = ReadValue( value, settings.unbreakable ) && settings.unbreakable >= 0.0;
+		else if ( key == "cluster" )
+			isValid = ReadValue( value, settings.clusterSize ) && settings.clusterSize > 0;
+		else if ( key == "width" )
+			isValid = ReadValue( value, settings.width ) && settings.width > 0;
+		else if ( key == "height" )
+			isValid = ReadValue( value, settings.height ) && settings.height > 0;
+		else if ( key == "seed" )
+			isValid = ReadValue( value, settings.seed );
+
+		if ( !isValid )
+		{
+			std::cout << "Error! Bad board generator setting : " << setting << " in " << name << std::endl;
+			return false;
+		}
+	}
+
+	if ( ( settings.regular + settings.explosive + settings.hard + settings.unbreakable ) <= 0.0 )
+	{
+		std::cout << "Error! Board generator needs at least one tile type in " << name << std::endl;
+		return false;
+	}
+
+	return true;
+}
+Board BoardGenerator::Generate( const BoardGeneratorSettings &settings )
+{
+	Board board;
+
+	const uint32_t tileCount = settings.tileCount;
+
+	if ( tileCount == 0 )
+		return board;
+
+	RandomGenerator random;
+	random.Seed( settings.seed );
+
+	// A grid with the same shape as the resolution, big enough that the tiles fill density of it
+	uint32_t cellCount = std::max( tileCount, static_cast< uint32_t > ( std::ceil( tileCount / settings.density ) ) );
+	double aspect = ( settings.width / stepX ) / ( settings.height / stepY );
+
+	uint32_t columns = std::max( 1u, static_cast< uint32_t > ( std::round( std::sqrt( cellCount * aspect ) ) ) );
+	uint32_t rows = ( cellCount + columns - 1 ) / columns;
+	cellCount = columns * rows;
+
+	// Partial Fisher-Yates, picks tileCount different cells
+	std::vector< uint32_t > cells( cellCount );
+	std::iota( cells.begin(), cells.end(), 0u );
+
+	for ( uint32_t i = 0; i < tileCount; ++i )
+		std::swap( cells[i], cells[ i + NextBelow( random, cellCount - i ) ] );
+
+	// The tile in each cell, or -1. Numbered in cell order, so the board is built row by row
+	std::vector< int32_t > cellTile( cellCount, -1 );
+
+	for ( uint32_t i = 0; i < tileCount; ++i )
+		cellTile[ cells[i] ] = 0;
+
+	std::vector< uint32_t > tileCell;
+	tileCell.reserve( tileCount );
+
+	for ( uint32_t cell = 0; cell < cellCount; ++cell )
+	{
+		if ( cellTile[ cell ] < 0 )
+			continue;
+
+		cellTile[ cell ] = static_cast< int32_t > ( tileCell.size() );
+		tileCell.push_back( cell );
+	}
+
+	// Every explosive tile that is rolled starts a cluster, so it's rolled less often to keep the mix close to the weights
+	double averageCluster = ( 1.0 + settings.clusterSize ) / 2.0;
+	double explosiveSeed = settings.explosive / averageCluster;
+	double totalWeight = settings.regular + explosiveSeed + settings.hard + settings.unbreakable;
+
+	std::vector< TileType > types( tileCount, TileType::Regular );
+	std::vector< bool > isTyped( tileCount, false );
+	std::vector< uint32_t > cluster;
+
+	for ( uint32_t tile = 0; tile < tileCount; ++tile )
+	{
+		if ( isTyped[ tile ] )
+			continue;
+
+		isTyped[ tile ] = true;
+
+		double roll = random.NextDouble() * totalWeight;
+
+		if ( roll < settings.regular )
+			types[ tile ] = TileType::Regular;
+		else if ( roll < settings.regular + settings.hard )
+			types[ tile ] = TileType::Hard;
+		else if ( roll < settings.regular + settings.hard + settings.unbreakable )
+			types[ tile ] = TileType::Unbreakable;
+		else
+			types[ tile ] = TileType::Explosive;
+
+		if ( types[ tile ] != TileType::Explosive )
+			continue;
+
+		// Grows the cluster into the neighbouring tiles that don't have a type yet
+		uint32_t clusterSize = 1 + NextBelow( random, settings.clusterSize );
+		uint32_t added = 1;
+
+		cluster.clear();
+		cluster.push_back( tileCell[ tile ] );
+
+		for ( size_t i = 0; i < cluster.size() && added < clusterSize; ++i )
+		{
+			uint32_t cell = cluster[i];
+			uint32_t column = cell % columns;
+
+			uint32_t neighbours[ 4 ];
+			uint32_t neighbourCount = 0;
+
+			if ( column > 0 )
+				neighbours[ neighbourCount++ ] = cell - 1;
+			if ( column + 1 < columns )
+				neighbours[ neighbourCount++ ] = cell + 1;
+			if ( cell >= columns )
+				neighbours[ neighbourCount++ ] = cell - columns;
+			if ( cell + columns < cellCount )
+				neighbours[ neighbourCount++ ] = cell + columns;
+
+			for ( uint32_t j = 0; j < neighbourCount && added < clusterSize; ++j )
+			{
+				int32_t neighbour = cellTile[ neighbours[j] ];
+
+				if ( neighbour < 0 || isTyped[ static_cast< uint32_t > ( neighbour ) ] )
+					continue;
+
+				isTyped[ static_cast< uint32_t > ( neighbour ) ] = true;
+				types[ static_cast< uint32_t > ( neighbour ) ] = TileType::Explosive;
+
+				cluster.push_back( neighbours[j] );
+				++added;
+			}
+		}
+	}
+
+	for ( uint32_t tile = 0; tile < tileCount; ++tile )
+	{
+		uint32_t cell = tileCell[ tile ];
+		board.AddTile( TilePosition( ( cell % columns ) * stepX, ( cell / columns ) * stepY, types[ tile ] ) );
+	}
+
+	return board;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+#include "structs/board/Board.h"
+
+// What a generated board should look like. Read from a board name like "generate:tiles=100000,density=0.7,seed=3"
+struct BoardGeneratorSettings
+{
+	BoardGeneratorSettings()
+		:	tileCount( 1000 )
+		,	density( 0.8 )
+		,	regular( 70.0 )
+		,	explosive( 10.0 )
+		,	hard( 15.0 )
+		,	unbreakable( 5.0 )
+		,	clusterSize( 3 )
+		,	width( 1920 )
+		,	height( 1080 )
+		,	seed( 1 )
+	{
+	}
+
+	// tiles
+	uint32_t tileCount;
+	// density, how much of the grid the tiles fill ( 0.0, 1.0 ]
+	double density;
+
+	// regular, explosive, hard, unbreakable. How often each type is picked, they don't have to add up to anything
+	double regular;
+	double explosive;
+	double hard;
+	double unbreakable;
+
+	// cluster, explosive tiles come in groups of 1 to clusterSize neighbours, so one explosion sets off the others
+	uint32_t clusterSize;
+
+	// width, height. The board gets the same shape as this resolution, the game scales it to fit the window
+	int32_t width;
+	int32_t height;
+
+	// seed, the same settings and seed always give the same board
+	uint64_t seed;
+};
+
+// Builds boards instead of reading them from boards/, for benchmarks and for testing boards far bigger than anyone would write by hand
+// A generator board can be used anywhere a board file can : in boards/boardlist.txt, or with -board
+class BoardGenerator
+{
+	public:
+		// Starts with "generate:"
+		static bool IsGeneratorName( const std::string &name );
+
+		// Settings that aren't in the name keep their default. Returns false if a setting is unknown or has a bad value
+		static bool ParseName( const std::string &name, BoardGeneratorSettings &settings );
+
+		// The tiles are laid out on the same 65 x 25 grid as the boards in boards/
+		static Board Generate( const BoardGeneratorSettings &settings );
+};
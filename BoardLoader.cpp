@@ -1,4 +1,5 @@
 #include "BoardLoader.h"
+#include "BoardGenerator.h"
 
 #include "structs/game_objects/Tile.h"
 #include "structs/board/TilePosition.h"
@@ -26,9 +27,14 @@ void BoardLoader::BuildLevelList()
 	std::string line;
 	std::ifstream boardFile( "boards/boardlist.txt" );
 
+	levelTextFiles.clear();
+
 	while ( getline( boardFile, line ) )
 	{
-		if ( line[0] == '#' || line.empty() || !DoesFileExist( "boards/" + line ))
+		if ( line.empty() || line[0] == '#' )
+			continue;
+
+		if ( !IsValidBoardName( line ) )
 			continue;
 
 		logger->Log( __FILE__, __LINE__, "Added file : ", line );
@@ -64,12 +70,33 @@ Board BoardLoader::LoadLevel( const std::string &textFile )
 }
 bool BoardLoader::IsLastLevel()
 {
-	return currentLevel == levelTextFiles.size();
+	// The list can be reloaded shorter than how far the game has come
+	return currentLevel >= levelTextFiles.size();
+}
+Board BoardLoader::LoadOrGenerate( const std::string &name )
+{
+	if ( !BoardGenerator::IsGeneratorName( name ) )
+		return LoadLevel( "boards/" + name );
+
+	BoardGeneratorSettings settings;
+
+	if ( !BoardGenerator::ParseName( name, settings ) )
+	{
+		Board board;
+		board.levelName = name;
+		return board;
+	}
+
+	Board board = BoardGenerator::Generate( settings );
+	board.levelName = name;
+
+	logger->Log( __FILE__, __LINE__, "Generated board : ", name );
+
+	return board;
 }
 Board BoardLoader::GenerateBoard( const SDL_Rect &rect )
 {
-	std::string level = "boards/" + levelTextFiles[ currentLevel++ ];
-	Board b = LoadLevel( level );
+	Board b = LoadOrGenerate( levelTextFiles[ currentLevel++ ] );
 	levels.push_back( b );
 
 	b.CenterAndFlip( rect );
@@ -77,6 +104,24 @@ Board BoardLoader::GenerateBoard( const SDL_Rect &rect )
 
 	return b;
 }
+Board BoardLoader::GenerateBoard( const std::string &textFile, const SDL_Rect &rect )
+{
+	Board b = LoadOrGenerate( textFile );
+
+	b.CenterAndFlip( rect );
+	b.CalcMaxScale( rect );
+
+	return b;
+}
+bool BoardLoader::IsValidBoardName( const std::string &name ) const
+{
+	if ( !BoardGenerator::IsGeneratorName( name ) )
+		return DoesFileExist( "boards/" + name );
+
+	// ParseName prints what's wrong with the settings
+	BoardGeneratorSettings settings;
+	return BoardGenerator::ParseName( name, settings );
+}
 bool BoardLoader::DoesFileExist( const std::string &fileName ) const
 {
 	std::ifstream file( fileName );
@@ -13,7 +13,10 @@ struct BoardLoader
 
 	Board LoadLevel( const std::string &textFile );
 
+	// The names are files in boards/, or settings for BoardGenerator ( "generate:tiles=1000,seed=2" )
 	Board GenerateBoard( const SDL_Rect &rect );
+	// Same as above, but with the given board instead of the next one in the level list
+	Board GenerateBoard( const std::string &textFile, const SDL_Rect &rect );
 
 	bool IsLastLevel();
 
@@ -22,6 +25,9 @@ struct BoardLoader
 		currentLevel = 0;
 	}
 	private:
+	Board LoadOrGenerate( const std::string &name );
+	// A file that exists in boards/, or a generator name with valid settings
+	bool IsValidBoardName( const std::string &name ) const;
 	bool DoesFileExist( const std::string &fileName ) const;
 
 	size_t currentLevel;
@@ -10,10 +10,25 @@
 #include "tools/SDLColorHelper.h"
 
 void ConfigLoader::LoadConfig()
+{
+	ReadConfig();
+	PrintConfig();
+}
+void ConfigLoader::ReadConfig()
 {
 	std::ifstream configFile( "config/Config.txt" );
 	std::string configLine;
 
+	configValues[ Index( ConfigValueType::AIPaddleSpeed ) ] = 1500.0;
+
+	// Network simulation is off unless Config.txt says otherwise
+	configValues[ Index( ConfigValueType::NetLatency ) ] = 0.0;
+	configValues[ Index( ConfigValueType::NetJitter ) ] = 0.0;
+	configValues[ Index( ConfigValueType::NetBandwidth ) ] = 0.0;
+	configValues[ Index( ConfigValueType::NetReorderChance ) ] = 0.0;
+	configValues[ Index( ConfigValueType::NetLossChance ) ] = 0.0;
+	configValues[ Index( ConfigValueType::NetDisconnectAfter ) ] = 0.0;
+
 	while ( getline( configFile, configLine ) )
 	{
 		if ( configLine[0] == '#' || configLine.empty() )
@@ -30,15 +45,17 @@ void ConfigLoader::LoadConfig()
 			isFastMode = ( fastMode.find( "true" ) != std::string::npos );
 		}
 		else if (  configLine.find( "ball_speed_normal" ) != std::string::npos )
-			ss >> configValues[ ConfigValueType::BallSpeed ];
+			ss >> configValues[ Index( ConfigValueType::BallSpeed ) ];
 		else if (  configLine.find( "ball_speed_fastmode" ) != std::string::npos )
-			ss >> configValues[ ConfigValueType::BallSpeed_FM ];
+			ss >> configValues[ Index( ConfigValueType::BallSpeed_FM ) ];
 		else if (  configLine.find( "bullet_speed" ) != std::string::npos )
-			ss >> configValues[ ConfigValueType::BulletSpeed ];
+			ss >> configValues[ Index( ConfigValueType::BulletSpeed ) ];
 		else if (  configLine.find( "bonus_box_speed" ) != std::string::npos )
-			ss >> configValues[ ConfigValueType::BonusBoxSpeed ];
+			ss >> configValues[ Index( ConfigValueType::BonusBoxSpeed ) ];
 		else if (  configLine.find( "bonus_box_chance" ) != std::string::npos )
-			ss >> configValues[ ConfigValueType::BonusBoxChance ];
+			ss >> configValues[ Index( ConfigValueType::BonusBoxChance ) ];
+		else if (  configLine.find( "ai_paddle_speed" ) != std::string::npos )
+			ss >> configValues[ Index( ConfigValueType::AIPaddleSpeed ) ];
 		else if (  configLine.find( "points_regular" ) != std::string::npos )
 			ss >> points[TileType::Regular];
 		else if (  configLine.find( "points_hard" ) != std::string::npos )
@@ -48,10 +65,20 @@ void ConfigLoader::LoadConfig()
 		else if (  configLine.find( "points_unbreakable" ) != std::string::npos )
 			ss >> points[TileType::Unbreakable];
 		else if (  configLine.find( "points_hit" ) != std::string::npos )
-			ss >> configValues[ ConfigValueType::PointsHit ];
+			ss >> configValues[ Index( ConfigValueType::PointsHit ) ];
+		else if (  configLine.find( "net_latency" ) != std::string::npos )
+			ss >> configValues[ Index( ConfigValueType::NetLatency ) ];
+		else if (  configLine.find( "net_jitter" ) != std::string::npos )
+			ss >> configValues[ Index( ConfigValueType::NetJitter ) ];
+		else if (  configLine.find( "net_bandwidth" ) != std::string::npos )
+			ss >> configValues[ Index( ConfigValueType::NetBandwidth ) ];
+		else if (  configLine.find( "net_reorder_chance" ) != std::string::npos )
+			ss >> configValues[ Index( ConfigValueType::NetReorderChance ) ];
+		else if (  configLine.find( "net_loss_chance" ) != std::string::npos )
+			ss >> configValues[ Index( ConfigValueType::NetLossChance ) ];
+		else if (  configLine.find( "net_disconnect_after" ) != std::string::npos )
+			ss >> configValues[ Index( ConfigValueType::NetDisconnectAfter ) ];
 	}
-
-	PrintConfig();
 }
 void ConfigLoader::PrintColor( const std::string &colorName, const SDL_Color &color )
 {
@@ -2,6 +2,7 @@
 
 #include <string>
 
+#include <array>
 #include <vector>
 #include <map>
 
@@ -15,56 +16,89 @@ class ConfigLoader
 {
 	public:
 	ConfigLoader()
+		:	configValues()
+		,	points()
+		,	isFastMode( false )
 	{
 
 	}
+	// Reads config/Config.txt and prints it
 	void LoadConfig();
+	// Only reads, so it can be used from other threads without touching std::cout
+	void ReadConfig();
+	void PrintConfig();
 
 	bool IsFastMode() const
 	{
 		return isFastMode;
 	}
-	double GetTilePoints( const TileType &tt )
+	double GetTilePoints( const TileType &tt ) const
 	{
-		return points[tt];
+		auto tilePoints = points.find( tt );
+		return ( tilePoints != points.end() ) ? tilePoints->second : 0.0;
 	}
 	std::map< TileType, int32_t > GetPoints() const
 	{
 		return points;
 	}
+	void SetTilePoints( const TileType &tt, int32_t tilePoints )
+	{
+		points[tt] = tilePoints;
+	}
 	void ApplyChange( ConfigValueType config, double value, PlussMin plussMin )
 	{
+		double &configValue = configValues[ Index( config ) ];
+
 		if ( plussMin == PlussMin::Pluss )
-			configValues[config] += value;
+			configValue += value;
 		else if ( plussMin == PlussMin::Minus )
 		{
-			if ( configValues[config] > value )
-				configValues[config] -= value;
+			if ( configValue > value )
+				configValue -= value;
 		}
 		else if ( plussMin == PlussMin::Flip )
 			isFastMode = !isFastMode;
 	}
+	// Called every frame, so the values are kept in an array indexed by ConfigValueType. Values that aren't set are 0
 	double Get( ConfigValueType config ) const
 	{
-		return configValues.at( config );
+		return configValues[ Index( config ) ];
 	}
 	void Set( double value, ConfigValueType config )
 	{
-		configValues[config] = value;
+		configValues[ Index( config ) ] = value;
+	}
+	// All values, for the replay header
+	std::map< ConfigValueType, double > GetValues() const
+	{
+		std::map< ConfigValueType, double > values;
+
+		for ( size_t i = 0; i < configValues.size(); ++i )
+			values[ static_cast< ConfigValueType > ( i ) ] = configValues[i];
+
+		return values;
 	}
 
 	bool GetFastMode( ) const
 	{
 		return isFastMode;
 	}
+	void SetFastMode( bool isFastMode_ )
+	{
+		isFastMode = isFastMode_;
+	}
 
 	private:
+	static size_t Index( ConfigValueType config )
+	{
+		return static_cast< size_t > ( config );
+	}
+
 	void PrintColor( const std::string &colorName, const SDL_Color &color );
 	void PrintIndented( const std::string &colorName );
-	void PrintConfig();
 	std::string RemoveCharacterFromString( std::string str, char ch );
 
-	std::map< ConfigValueType, double > configValues;
+	std::array< double, static_cast< size_t > ( ConfigValueType::Count ) > configValues;
 	std::map< TileType, int32_t > points;
 
 	bool isFastMode;
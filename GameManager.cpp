@@ -9,7 +9,7 @@
 #include "structs/board/Board.h"
 #include "structs/net/TCPMessage.h"
 
-#include "math/Math.h"
+#include "math/RandomService.h"
 #include "math/RectHelpers.h"
 #include "math/VectorHelpers.h"
 
@@ -17,8 +17,12 @@
 #include "enums/LobbyMenuItem.h"
 #include "enums/MessageTarget.h"
 #include "enums/ConfigValueType.h"
+#include "enums/ReplayRecordType.h"
 
+#include <chrono>
 #include <vector>
+#include <thread>
+#include <cstring>
 #include <sstream>
 #include <algorithm>
 
@@ -26,12 +30,15 @@
 #include "BoardLoader.h"
 #include "ConfigLoader.h"
 
+#include "tools/RenderThread.h"
+
 	GameManager::GameManager()
 	:	renderer()
 	,	timer()
 	,	menuManager( gameConfig )
 	,	messageSender( netManager )
 	,	physicsManager( messageSender )
+	,	gameRules( physicsManager, gameConfig, localPlayerInfo, remotePlayerInfo )
 
 	,	runGame( true )
 
@@ -41,13 +48,37 @@
 	,	isAIControlled( false )
 
 	,	ballList()
+	,	deadPieces()
 	,	windowSize()
+	,	field( ViewTransform::GetField() )
+
+	,	lastPingSent( 0 )
 
-	,	remoteResolutionScale( 1.0 )
+	,	udpHandshakeSent( false )
+	,	lastBallStateRefresh( 0 )
+
+	,	replayPlayer()
+	,	replayRecorder()
+	,	recordFile()
+	,	isHeadless( false )
+	,	replayDesynced( false )
+	,	randomService()
+	,	gameTicks( 0 )
 
 	,	fpsLimit( 60 )
 	,	frameDuration( 1000.0 / 60.0 )
 
+	,	useRenderThread( true )
+	,	eventMutex()
+	,	eventQueue()
+
+	,	boardFile()
+	,	ballStorm()
+
+	,	configWatcher()
+	,	configChanges()
+	,	configOverrides()
+
 	,	stick( nullptr )
 	,	respawnBalls( false )
 
@@ -56,6 +87,20 @@
 	windowSize.y = 0;
 	windowSize.w = 1920 / 2;
 	windowSize.h = 1080 / 2;
+
+	gameRules.SetListener( this );
+}
+bool GameManager::LoadReplay( const std::string &fileName, bool headless )
+{
+	if ( !replayPlayer.Load( fileName ) )
+		return false;
+
+	isHeadless = headless;
+	return true;
+}
+void GameManager::SetRecordFile( const std::string &fileName )
+{
+	recordFile = fileName;
 }
 bool GameManager::Init( const std::string &localPlayerName_,  const SDL_Rect &size, bool startFS )
 {
@@ -64,12 +109,26 @@ bool GameManager::Init( const std::string &localPlayerName_,  const SDL_Rect &si
 	windowSize = size;
 	bool server = localPlayerName_ ==  "server";
 
+	if ( replayPlayer.IsPlaying() )
+	{
+		// The mouse events are recorded in screen pixels, so the screen has to be the same size as in the recorded game
+		windowSize.w = replayPlayer.GetHeader().width;
+		windowSize.h = replayPlayer.GetHeader().height;
+	}
+
+	if ( isHeadless )
+	{
+		SDL_setenv( "SDL_VIDEODRIVER", "dummy", 1 );
+		SDL_setenv( "SDL_AUDIODRIVER", "dummy", 1 );
+	}
+
 	if ( !renderer.Init( windowSize, startFS, server ) )
 		return false;
 
 	RenderMainText();
 
-	physicsManager.SetWindowSize( windowSize );
+	physicsManager.SetWindowSize( field );
+	gameRules.SetWindowSize( field );
 
 	gameConfig.LoadConfig();
 	LoadConfig();
@@ -82,6 +141,9 @@ bool GameManager::Init( const std::string &localPlayerName_,  const SDL_Rect &si
 	logger = Logger::Instance();
 	logger->Init( localPlayerName_ );
 
+	if ( !replayPlayer.IsPlaying() && recordFile.empty() && !configWatcher.Start() )
+		logger->Log( __FILE__, __LINE__, "Can't watch config/ and boards/, changes need a restart" );
+
 	return true;
 }
 void GameManager::InitMenu()
@@ -102,6 +164,7 @@ void GameManager::InitPaddles()
 
 	physicsManager.SetPaddles( localPaddle, remotePaddle );
 	physicsManager.SetPaddleData( );
+	gameRules.SetPaddles( localPaddle, remotePaddle );
 
 	renderer.SetLocalPaddle( localPaddle );
 	renderer.SetRemotePaddle( remotePaddle );
@@ -111,12 +174,31 @@ void GameManager::InitNetManager( std::string ip_, uint16_t port_ )
 	ip = ip_;
 	port = port_;
 
+	// Replays get their messages from the replay file
+	if ( replayPlayer.IsPlaying() )
+		return;
+
 	netManager.Init( false  );
+
+	ApplyNetworkConditions();
+}
+void GameManager::ApplyNetworkConditions()
+{
+	NetworkConditions conditions;
+	conditions.latency = gameConfig.Get( ConfigValueType::NetLatency );
+	conditions.jitter = gameConfig.Get( ConfigValueType::NetJitter );
+	conditions.bandwidth = gameConfig.Get( ConfigValueType::NetBandwidth );
+	conditions.reorderChance = gameConfig.Get( ConfigValueType::NetReorderChance );
+	conditions.lossChance = gameConfig.Get( ConfigValueType::NetLossChance );
+	conditions.disconnectAfter = gameConfig.Get( ConfigValueType::NetDisconnectAfter );
+
+	netManager.SetNetworkConditions( conditions );
 }
 void GameManager::LoadConfig()
 {
 	physicsManager.SetBulletSpeed( gameConfig.Get( ConfigValueType::BulletSpeed ) );
 	physicsManager.SetBonusBoxSpeed( gameConfig.Get( ConfigValueType::BonusBoxSpeed ) );
+	physicsManager.SetAIPaddleSpeed( gameConfig.Get( ConfigValueType::AIPaddleSpeed ) );
 
 	localPlayerInfo.ballSpeed = gameConfig.Get( ConfigValueType::BallSpeed );
 	remotePlayerInfo.ballSpeed = gameConfig.Get( ConfigValueType::BallSpeed );
@@ -124,6 +206,67 @@ void GameManager::LoadConfig()
 	localPlayerInfo.fastMode = gameConfig.GetFastMode();
 	remotePlayerInfo.fastMode = gameConfig.GetFastMode();
 }
+void GameManager::ApplyChangedConfig( const ConfigLoader &oldConfig )
+{
+	auto hasChanged = [ & ]( ConfigValueType type )
+	{
+		return gameConfig.Get( type ) != oldConfig.Get( type );
+	};
+
+	if ( hasChanged( ConfigValueType::BulletSpeed ) )
+		physicsManager.SetBulletSpeed( gameConfig.Get( ConfigValueType::BulletSpeed ) );
+
+	if ( hasChanged( ConfigValueType::BonusBoxSpeed ) )
+		physicsManager.SetBonusBoxSpeed( gameConfig.Get( ConfigValueType::BonusBoxSpeed ) );
+
+	if ( hasChanged( ConfigValueType::AIPaddleSpeed ) )
+		physicsManager.SetAIPaddleSpeed( gameConfig.Get( ConfigValueType::AIPaddleSpeed ) );
+
+	if (	hasChanged( ConfigValueType::NetLatency )
+		||	hasChanged( ConfigValueType::NetJitter )
+		||	hasChanged( ConfigValueType::NetBandwidth )
+		||	hasChanged( ConfigValueType::NetReorderChance )
+		||	hasChanged( ConfigValueType::NetLossChance )
+		||	hasChanged( ConfigValueType::NetDisconnectAfter ) )
+	{
+		ApplyNetworkConditions();
+	}
+
+	// The ball speeds and fast mode are left alone, bonuses and fast mode change them during a level
+	// and the other player wouldn't get the change. The new values are used the next time LoadConfig() resets them
+}
+void GameManager::ApplyConfigChanges()
+{
+	if ( !configWatcher.TakeChanges( configChanges ) )
+		return;
+
+	if ( configChanges.hasConfig )
+	{
+		ConfigLoader oldConfig = gameConfig;
+		gameConfig = configChanges.config;
+
+		for ( const auto &p : configOverrides )
+			gameConfig.Set( p.second, p.first );
+
+		ApplyChangedConfig( oldConfig );
+
+		logger->Log( __FILE__, __LINE__, "Reloaded config/Config.txt" );
+		gameConfig.PrintConfig();
+	}
+
+	if ( configChanges.hasColors )
+	{
+		renderer.ApplyColorConfig( configChanges.colors );
+		logger->Log( __FILE__, __LINE__, "Reloaded config/ColorCfg.txt" );
+	}
+
+	// Boards are read from file when they're played, only the list has to be read again
+	if ( configChanges.hasBoards )
+	{
+		boardLoader.BuildLevelList();
+		logger->Log( __FILE__, __LINE__, "Reloaded boards/boardlist.txt" );
+	}
+}
 void GameManager::CreateMenu()
 {
 	renderer.InitGameList();
@@ -167,6 +310,9 @@ void GameManager::Restart()
 	logger->Log( __FILE__, __LINE__, "======================= RESET =======================");
 
 	boardLoader.Reset();
+
+	// Anything that died since the last tick is handled like any other death, before everything is cleared
+	RemoveDeadPieces();
 	ClearBoard();
 
 	DeleteAllBonusBoxes();
@@ -175,6 +321,8 @@ void GameManager::Restart()
 
 	localPlayerInfo.Reset();
 	remotePlayerInfo.Reset();
+	remoteClock.Reset();
+	udpHandshakeSent = false;
 
 	localPaddle->ResetSize();
 
@@ -205,7 +353,7 @@ std::shared_ptr<Ball> GameManager::AddBall( Player owner, unsigned int ballID )
 	if ( owner == Player::Local )
 	{
 		ball = physicsManager.CreateBall( owner, 0, GetBallSpeed( owner ) );
-		messageSender.SendBallSpawnMessage( ball, windowSize.h );
+		messageSender.SendBallSpawnMessage( ball );
 	}
 	else
 	{
@@ -251,53 +399,16 @@ bool GameManager::CanPlayerFireBall( const Player &player ) const
 
 	return true;
 }
-void GameManager::RemoveBall( std::shared_ptr< Ball > ball )
-{
-	ReduceActiveBalls( ball->GetOwner(), ball->GetObjectID() );
-
-	renderer.RemoveBall( ball );
-	physicsManager.RemoveBall( ball );
-
-	RenderMainText();
-}
-void GameManager::ReduceActiveBalls( const Player &player, uint32_t ballID )
-{
-	if ( player ==  Player::Local )
-	{
-		--localPlayerInfo.activeBalls;
-
-		messageSender.SendBallKilledMessage( ballID );
-
-		if ( localPlayerInfo.activeBalls == 0 )
-			ReducePlayerLifes( Player::Local );
-
-		renderer.RenderBallCount( localPlayerInfo.activeBalls, Player::Local );
-	}
-	else
-	{
-		--remotePlayerInfo.activeBalls;
-
-		if ( remotePlayerInfo.activeBalls == 0 )
-			ReducePlayerLifes( Player::Remote );
-
-		renderer.RenderBallCount( remotePlayerInfo.activeBalls, Player::Remote );
-	}
-}
 void GameManager::AddTile( const Vector2f &pos, TileType tileType, int32_t tileID  )
 {
 	const auto &tile = physicsManager.CreateTile( pos, tileType, tileID  );
 
 	if ( netManager.IsServer() )
-		messageSender.SendTileSpawnMessage( tile, windowSize.h );
+		messageSender.SendTileSpawnMessage( tile );
 
 	tileList.push_back( tile );
 	renderer.AddTile( tile );
 }
-void GameManager::RemoveTile( std::shared_ptr< Tile > tile )
-{
-	renderer.RemoveTile( tile );
-	physicsManager.RemoveTile( tile );
-}
 void GameManager::AddBonusBox( std::shared_ptr< Ball > triggerBall, double x, double y, int tilesDestroyed /* = 1 */ )
 {
 	AddBonusBox( triggerBall->GetOwner(), triggerBall->GetDirection(), { x, y }, tilesDestroyed );
@@ -312,7 +423,7 @@ void GameManager::AddBonusBox( const Player &owner, Vector2f dir,  const Vector2
 	bonusBoxList.push_back( bonusBox );
 	renderer.AddBonusBox( bonusBox );
 
-	messageSender.SendBonusBoxSpawnedMessage( bonusBox, windowSize.h );
+	messageSender.SendBonusBoxSpawnedMessage( bonusBox );
 }
 bool GameManager::WasBonusBoxSpawned( int32_t tilesDestroyed ) const
 {
@@ -323,7 +434,7 @@ bool GameManager::WasBonusBoxSpawned( int32_t tilesDestroyed ) const
 		randMax = static_cast< int > ( probabilityOfBonus * randMax );
 	}
 
-	int32_t rand = static_cast< int32_t > ( RandomHelper::GenRandomNumber( ( randMax > 0 ) ? randMax : 1 ) );
+	int32_t rand = static_cast< int32_t > ( RandomService::Get( RandomStream::Gameplay ).GenRandomNumber( ( randMax > 0 ) ? randMax : 1 ) );
 	return (  rand == 1 );
 }
 void GameManager::RemoveBonusBox( std::shared_ptr< BonusBox >  bb )
@@ -335,26 +446,7 @@ void GameManager::UpdateBalls( double delta )
 {
 	CheckBallSpeedFastMode( delta );
 
-	for ( const auto &p : ballList )
-	{
-		p->Update( delta );
-
-		if ( p->GetOwner() == Player::Remote )
-			continue;
-
-		if ( p->BoundCheck( windowSize ) || p->PaddleCheck( localPaddle->rect )  )
-		{
-			messageSender.SendBallDataMessage( p, windowSize.h );
-			continue;
-		}
-
-		CheckBallTileIntersection( p );
-
-		if ( p->DeathCheck( windowSize ) )
-			p->Kill();
-	}
-
-	DeleteDeadBalls();
+	gameRules.UpdateBalls( ballList, delta );
 }
 void GameManager::UpdateBullets( double delta )
 {
@@ -362,14 +454,11 @@ void GameManager::UpdateBullets( double delta )
 	{
 		bullet->Update( delta );
 
-		if ( bullet->GetOwner()  == Player::Remote )
+		if ( bullet->GetOwner()  == Player::Remote || !bullet->IsAlive() )
 			continue;
 
 		CheckBulletTileIntersections( bullet );
 	}
-
-	DeleteDeadBullets();
-	DeleteDeadTiles();
 }
 void GameManager::CheckBulletOutOfBounds( std::shared_ptr< Bullet > bullet )
 {
@@ -399,33 +488,15 @@ void GameManager::CheckBulletTileIntersections(  std::shared_ptr< Bullet > bulle
 void GameManager::HandleBulletTileIntersection( std::shared_ptr< Bullet > bullet, std::shared_ptr< Tile > tile )
 {
 	Player owner = bullet->GetOwner();
+	bool isSuperBullet = IsSuperBullet( owner );
 
-	renderer.GenerateParticleEffect( tile );
-
-	if ( !IsSuperBullet( owner ) )
-	{
-		tile->Hit();
+	if ( !isSuperBullet )
 		bullet->Kill();
-	}
-	else
-		tile->Kill();
 
-	bool alive = tile->IsAlive();
+	int32_t count = gameRules.HitTile( tile, owner, isSuperBullet );
 
-	int32_t count = 1;
-	if ( tile->GetTileType() == TileType::Explosive )
-		count = HandleExplosions( tile, owner );
-	else
-	{
-		IncrementPoints( tile->GetTileType(), !alive, owner );
-		messageSender.SendTileHitMessage( tile->GetObjectID() );
-		renderer.UpdateTileHit( tile );
-	}
-
-	DeleteDeadTiles();
-
-	if ( !alive && bullet->GetOwner() == Player::Local )
-		AddBonusBox( bullet->GetOwner(), Vector2f( 0.0f, 1.0f ), tile->GetPosition(), count );
+	if ( !tile->IsAlive() && owner == Player::Local )
+		AddBonusBox( owner, Vector2f( 0.0f, 1.0f ), tile->GetPosition(), count );
 }
 bool GameManager::IsSuperBullet( const Player owner ) const
 {
@@ -437,60 +508,119 @@ bool GameManager::IsSuperBullet( const Player owner ) const
 
 	return false;
 }
-bool GameManager::AnyFastModeActive() const
-{
-	return ( localPlayerInfo.IsBonusActive( BonusType::SuperBall ) || remotePlayerInfo.IsBonusActive( BonusType::SuperBall ) );
-}
 void GameManager::UpdateNetwork()
 {
 	ReadMessagesFromServer();
 
-	if ( !menuManager.IsTwoPlayerMode() || !netManager.IsConnected() || menuManager.GetGameState() == GameState::InGameWait )
+	if ( !menuManager.IsTwoPlayerMode() || !CheckConnection( false ) || menuManager.GetGameState() == GameState::InGameWait )
 		return;
 
 	ReadMessages();
+	ReadUnreliableMessages();
+
+	SendUDPHandshake();
+	SendPing();
+	SendBallStateRefresh();
 }
-void GameManager::ReadMessages( )
+void GameManager::SendUDPHandshake()
+{
+	if ( udpHandshakeSent || !netManager.IsUDPRequested() )
+		return;
+
+	uint16_t udpPort = netManager.OpenUDP();
+
+	if ( udpPort != 0 )
+		messageSender.SendUDPHandshakeMessage( udpPort );
+
+	udpHandshakeSent = true;
+}
+void GameManager::SendBallStateRefresh()
+{
+	// Ball data is only sent on bounces. Over UDP any of those can be lost, so the state is repeated every now and then
+	const uint32_t refreshInterval = 100;
+
+	if ( !netManager.IsUDPActive() || menuManager.GetGameState() != GameState::InGame )
+		return;
+
+	uint32_t now = gameTicks;
+
+	if ( ( now - lastBallStateRefresh ) < refreshInterval )
+		return;
+
+	for ( const auto &p : ballList )
+	{
+		if ( p->GetOwner() == Player::Local )
+			messageSender.SendBallDataMessage( p );
+	}
+
+	lastBallStateRefresh = now;
+}
+void GameManager::SendPing()
 {
-	TCPMessage msg;
+	// The round trip time is used to figure out how old ball data messages are when they arrive
+	const uint32_t pingInterval = 1000;
+	uint32_t now = gameTicks;
+
+	if ( ( now - lastPingSent ) < pingInterval )
+		return;
 
-	while ( true  )
+	messageSender.SendPingMessage( now );
+	lastPingSent = now;
+}
+void GameManager::ReadMessages( )
+{
+	if ( replayPlayer.IsPlaying() )
 	{
-		std::string str = netManager.ReadMessage();
+		ReadReplayMessages();
+		return;
+	}
 
-		if ( str == "" )
-			break;
+	while ( netManager.ReadMessages( messageParser ) )
+	{
+		while ( messageParser.ParseNext( recievedMessage ) )
+			HandleRecieveMessage( recievedMessage );
 
-		std::stringstream ss;
-		ss << str;
+		netManager.ConsumeMessages( messageParser );
+	}
+}
+void GameManager::ReadUnreliableMessages( )
+{
+	if ( replayPlayer.IsPlaying() )
+	{
+		ReadReplayMessages();
+		return;
+	}
 
-		while ( ss >> msg )
-			HandleRecieveMessage( msg );
+	while ( netManager.ReadUnreliableMessages( messageParser ) )
+	{
+		while ( messageParser.ParseNext( recievedMessage ) )
+			HandleRecieveMessage( recievedMessage );
 	}
 }
 void GameManager::ReadMessagesFromServer( )
 {
-	TCPMessage msg;
-	while ( true  )
+	if ( replayPlayer.IsPlaying() )
 	{
-		std::string str = netManager.ReadMessageFromServer();
-
-		if ( str == "" )
-			break;
+		ReadReplayMessages();
+		return;
+	}
 
-		std::stringstream ss;
-		ss << str;
+	while ( netManager.ReadMessagesFromServer( messageParser ) )
+	{
+		while ( messageParser.ParseNext( recievedMessage ) )
+			HandleRecieveMessage( recievedMessage );
 
-		while ( ss >> msg )
-			HandleRecieveMessage( msg );
+		netManager.ConsumeMessagesFromServer( messageParser );
 	}
 }
 void GameManager::HandleRecieveMessage( const TCPMessage &message )
 {
+	replayRecorder.RecordMessage( message );
+
 	switch ( message.GetType() )
 	{
+		// Positions are logical, so the other player's resolution isn't needed
 		case MessageType::GameSettings:
-			remoteResolutionScale = windowSize.w / message.GetSize().x;
 			break;
 		case MessageType::GameStateChanged:
 			menuManager.SetGameState( message.GetGameState() );
@@ -539,7 +669,7 @@ void GameManager::HandleRecieveMessage( const TCPMessage &message )
 			RecieveBulletKillMessage( message );
 			break;
 		case MessageType::TileSpawned:
-			AddTile(  message.GetPos1(), message.GetTileType(), message.GetObjectID()  );
+			AddTile(  message.GetPos1().ToField(), message.GetTileType(), message.GetObjectID()  );
 			break;
 		case MessageType::LevelName:
 			logger->Log( __FILE__, __LINE__, "Setting level name", message.GetLevelName() );
@@ -549,6 +679,15 @@ void GameManager::HandleRecieveMessage( const TCPMessage &message )
 			logger->Log( __FILE__, __LINE__, "================================================================================");
 			physicsManager.UpdateScale();
 			break;
+		case MessageType::Ping:
+			messageSender.SendPongMessage( message.GetTimeStamp(), gameTicks );
+			break;
+		case MessageType::Pong:
+			RecievePongMessage( message );
+			break;
+		case MessageType::UDPHandshake:
+			netManager.ConnectUDP( message.GetPort() );
+			break;
 		default:
 			logger->Log( __FILE__, __LINE__, "UpdateNetwork unknown message received", message );
 			std::cin.ignore();
@@ -580,23 +719,33 @@ void GameManager::RecieveBallSpawnMessage( const TCPMessage &message )
 {
 	std::shared_ptr< Ball > ball = AddBall( Player::Remote, message.GetObjectID() );
 
-	ball->SetPosition( Math::Scale( message.GetPos1(),  remoteResolutionScale ) );
+	ball->SetPosition( message.GetPos1().ToField() );
 	ball->SetDirection( message.GetDir() );
-	ball->SetRemoteScale( remoteResolutionScale );
+
+	// Nothing has been shown yet, so the ball can be moved straight to where it is now
+	ball->Extrapolate( remoteClock.GetAge( message.GetTimeStamp(), gameTicks ), field );
 
 	renderer.RenderBallCount( remotePlayerInfo.activeBalls, Player::Remote );
 }
 void GameManager::RecieveBallDataMessage( const TCPMessage &message )
 {
-	std::shared_ptr< Ball > ball = physicsManager.GetBallWithID( message.GetObjectID(), Player::Remote );
+	// Ball data can come over UDP, so it might arrive after the ball was killed or before it was spawned
+	std::shared_ptr< Ball > ball = physicsManager.FindBallWithID( message.GetObjectID(), Player::Remote );
 
-	ball->SetPosition( Math::Scale( message.GetPos1(),  remoteResolutionScale ) );
-	ball->SetDirection( message.GetDir() );
+	if ( ball == nullptr )
+		return;
+
+	double age = remoteClock.GetAge( message.GetTimeStamp(), gameTicks );
+
+	ball->Reconcile( message.GetPos1().ToField(), message.GetDir(), age, field );
+}
+void GameManager::RecievePongMessage( const TCPMessage &message )
+{
+	remoteClock.AddSample( message.GetEchoTimeStamp(), message.GetTimeStamp(), gameTicks );
 }
 void GameManager::RecieveBallKillMessage( const TCPMessage &message )
 {
 	physicsManager.RemoveBallWithID( message.GetObjectID(), Player::Remote );
-	DeleteDeadBalls();
 }
 void GameManager::RecieveTileHitMessage( const TCPMessage &message )
 {
@@ -612,17 +761,15 @@ void GameManager::RecieveTileHitMessage( const TCPMessage &message )
 		renderer.UpdateTileHit( tile );
 	}
 
-	IncrementPoints( tile->GetTileType(), !tile->IsAlive(), Player::Remote );
-
-	DeleteDeadTiles();
+	gameRules.IncrementPoints( tile->GetTileType(), !tile->IsAlive(), Player::Remote );
 }
 void GameManager::RecievePaddlePosMessage( const TCPMessage &message )
 {
 	if ( !remotePaddle )
 		return;
 
-	double xPos = message.GetPos1().x;
-	if ( xPos > 0 && xPos < windowSize.w )
+	double xPos = message.GetPos1().ToField().x;
+	if ( xPos > 0 && xPos < field.w )
 	{
 		remotePaddle->rect.x = xPos;
 	}
@@ -631,7 +778,7 @@ void GameManager::RecieveBonusBoxSpawnedMessage( const TCPMessage &message )
 {
 	const auto &bonusBox = physicsManager.CreateBonusBox( message.GetObjectID(),  Player::Remote, message.GetDir_YFlipped(), Vector2f() );
 	bonusBox->SetBonusType( message.GetBonusType() );
-	bonusBox->SetPosition( Math::Scale( message.GetPos1(),  remoteResolutionScale ) );
+	bonusBox->SetPosition( message.GetPos1().ToField() );
 
 	bonusBoxList.push_back( bonusBox );
 	renderer.AddBonusBox( bonusBox );
@@ -647,88 +794,93 @@ std::shared_ptr< Bullet >  GameManager::FireBullet( int32_t id, const Player &ow
 }
 void GameManager::RecieveBulletFireMessage( const TCPMessage &message )
 {
-	FireBullet( message.GetObjectID() , Player::Remote, message.GetPos1() );
-	FireBullet( message.GetObjectID2(), Player::Remote, message.GetPos2() );
+	FireBullet( message.GetObjectID() , Player::Remote, message.GetPos1().ToField() );
+	FireBullet( message.GetObjectID2(), Player::Remote, message.GetPos2().ToField() );
 }
 void GameManager::RecieveBulletKillMessage( const TCPMessage &message )
 {
 	physicsManager.KillBulletWithID(  message.GetObjectID(), Player::Remote );
-
-	DeleteDeadBullets();
 }
 void GameManager::PrintRecv( const TCPMessage &msg, int32_t line  )
 {
 	logger->Log( __FILE__, line, msg.Print() );
 }
-void GameManager::DeleteDeadBalls()
+void GameManager::UpdateBallSpeed()
 {
-	bool localPlayerBallDeleted = false;
-	bool remotePlayerBallDeleted = false;
-	auto isDeadFunc = [&]( std::shared_ptr< Ball > ball )
+	physicsManager.UpdateBallSpeed( localPlayerInfo.ballSpeed, remotePlayerInfo.ballSpeed );
+}
+void GameManager::RemoveDeadPieces()
+{
+	// Nothing died this tick. Lost balls and lives are taken by GameRules, see OnBallLost and OnLifeLost
+	if ( !gameRules.TakeDeadPieces( deadPieces ) )
+		return;
+
+	for ( const auto &bullet : deadPieces.bullets )
 	{
-		if ( !ball || ball->IsAlive() )
-			return false;
+		if ( bullet->GetOwner() == Player::Local )
+			messageSender.SendBulletKilledMessage( bullet->GetObjectID() );
+	}
 
-		if ( ball->GetOwner() == Player::Local )
-			localPlayerBallDeleted = true;
-		else
-			remotePlayerBallDeleted = true;
+	renderer.RemoveDeadPieces( deadPieces );
+	physicsManager.RemoveDeadPieces( deadPieces );
 
-		RemoveBall( ball );
+	if ( !deadPieces.balls.empty() )
+	{
+		Graveyard::Compact( ballList );
+		RenderMainText();
+	}
 
-		return true;
-	};
+	if ( !deadPieces.tiles.empty() )
+		Graveyard::Compact( tileList );
 
-	auto newEnd = std::remove_if( ballList.begin(), ballList.end(), isDeadFunc );
+	if ( !deadPieces.bullets.empty() )
+		Graveyard::Compact( bulletList );
 
-	// Remove item returned by remove_if
-	ballList.erase( newEnd, ballList.end( ) );
+	if ( !deadPieces.bonusBoxes.empty() )
+		Graveyard::Compact( bonusBoxList );
+
+	deadPieces.Clear();
 }
-void GameManager::UpdateBallSpeed()
+void GameManager::OnBallBounced( const std::shared_ptr< Ball > &ball )
 {
-	physicsManager.UpdateBallSpeed( localPlayerInfo.ballSpeed, remotePlayerInfo.ballSpeed );
+	// Only the local balls are moved by GameRules, the remote ones are predicted
+	messageSender.SendBallDataMessage( ball );
 }
-void GameManager::DeleteDeadTiles()
+void GameManager::OnBallHitTile( const std::shared_ptr< Ball > &ball, const std::shared_ptr< Tile > &tile, int32_t tilesDestroyed )
 {
-	bool deadTile = false;
-	auto newEnd = std::remove_if(
-		tileList.begin(),
-		tileList.end(),
-	[=, &deadTile]( std::shared_ptr< Tile > tile )
-	{
-		if ( !tile || tile->IsAlive() )
-			return false;
-
-		deadTile = true;
-
-		RemoveTile( tile );
+	AddBonusBox( ball, tile->rect.x, tile->rect.y, tilesDestroyed );
+}
+void GameManager::OnTileHit( const std::shared_ptr< Tile > &tile )
+{
+	renderer.GenerateParticleEffect( tile );
+	renderer.UpdateTileHit( tile );
 
-		return true;
-	} );
-	// Remove item returned by remove_if
-	tileList.erase( newEnd, tileList.end( ) );
+	messageSender.SendTileHitMessage( tile->GetObjectID() );
 }
-void GameManager::DeleteDeadBullets()
+void GameManager::OnTileExploded( const std::shared_ptr< Tile > &tile )
 {
-	auto newEnd = std::remove_if(
-		bulletList.begin(),
-		bulletList.end(),
-	[=]( std::shared_ptr< Bullet > &bullet )
-	{
-		if ( !bullet || bullet->IsAlive() )
-			return false;
+	renderer.GenerateParticleEffect( tile );
 
-		renderer.RemoveBullet( (bullet ));
-		physicsManager.RemoveBullet( bullet );
+	messageSender.SendTileHitMessage( tile->GetObjectID(), true );
+}
+void GameManager::OnPointsChanged( const Player &player, uint32_t points )
+{
+	renderer.RenderPoints( points, player );
+}
+void GameManager::OnBallLost( const std::shared_ptr< Ball > &ball )
+{
+	Player owner = ball->GetOwner();
 
-		if ( bullet->GetOwner() == Player::Local )
-			messageSender.SendBulletKilledMessage( bullet->GetObjectID() );
+	if ( owner == Player::Local )
+		messageSender.SendBallKilledMessage( ball->GetObjectID() );
 
-		return true;
-	} );
+	renderer.RenderBallCount( gameRules.GetPlayerInfo( owner ).activeBalls, owner );
+}
+void GameManager::OnLifeLost( const Player &player )
+{
+	LoadConfig();
 
-	// Remove item returned by remove_if
-	bulletList.erase( newEnd, bulletList.end( ) );
+	renderer.RenderLives( gameRules.GetPlayerInfo( player ).lives, player );
 }
 void GameManager::DeleteAllBalls()
 {
@@ -780,7 +932,7 @@ void GameManager::DeleteAllBonusBoxes()
 }
 void GameManager::FireBullets()
 {
-	if (  !localPlayerInfo.CanFireBullet() )
+	if (  !localPlayerInfo.CanFireBullet( gameTicks ) )
 		return;
 
 	const auto &bullet1 = FireBullet
@@ -798,25 +950,121 @@ void GameManager::FireBullets()
 		pos2
 	);
 
-	messageSender.SendBulletFireMessage( bullet1, bullet2, windowSize.h );
+	messageSender.SendBulletFireMessage( bullet1, bullet2 );
 }
 void GameManager::Run()
+{
+	RandomService::SetCurrent( &randomService );
+	InitReplay();
+
+	unsigned int runStart = SDL_GetTicks();
+
+	// Nothing is presented in replays or headless games, so they gain nothing from a render thread
+	// A ball storm measures how long drawing takes, so it has to happen on this thread
+	if ( useRenderThread && !isHeadless && !replayPlayer.IsPlaying() && !ballStorm.IsRunning() )
+		RunWithRenderThread();
+	else
+		RunGameLoop();
+
+	if ( replayPlayer.IsPlaying() )
+		PrintReplayResult( SDL_GetTicks() - runStart );
+
+	replayRecorder.Stop();
+	RandomService::SetCurrent( nullptr );
+}
+void GameManager::RunWithRenderThread()
+{
+	// SDL only allows the renderer and the events to be used on the thread that created the window
+	// So this thread stays behind to draw and read events, and the game gets a thread of its own
+	RenderThread::Start();
+
+	std::thread gameThread( [ this ]()
+	{
+		// Every thread starts out with its own RandomService, not the one InitReplay seeded
+		RandomService::SetCurrent( &randomService );
+		RunGameLoop();
+		RandomService::SetCurrent( nullptr );
+		RenderThread::Finish();
+	} );
+
+	RenderFrame frameToDraw;
+	while ( !RenderThread::IsFinished() )
+	{
+		SDL_Event event;
+		while ( SDL_PollEvent( &event ) )
+			PushEvent( event );
+
+		if ( RenderThread::WaitForFrame( frameToDraw, 1 ) )
+			renderer.Draw( frameToDraw );
+	}
+
+	gameThread.join();
+	RenderThread::Stop();
+}
+void GameManager::RunGameLoop()
 {
 	unsigned int ticks;
 	while ( runGame )
 	{
 		ticks = SDL_GetTicks();
+		double delta = 0.0;
 
-		SDL_Event event;
-		while ( SDL_PollEvent( &event ) )
+		if ( replayPlayer.IsPlaying() )
 		{
-			HandleEvent( event );
+			if ( !ReadReplayFrame( delta ) )
+				break;
 		}
+		else
+		{
+			gameTicks = ticks;
+			delta = timer.GetDelta( );
 
+			replayRecorder.RecordTick( delta, gameTicks );
+
+			SDL_Event event;
+			while ( PollEvent( event ) )
+			{
+				replayRecorder.RecordEvent( event );
+				HandleEvent( event );
+			}
+		}
+
+		ApplyConfigChanges();
 		CheckForGameStateChange();
 
-		Update( timer.GetDelta( ) );
+		Update( delta );
+
+		// Everything sent during the frame goes out together
+		netManager.Flush();
+
+		EndFrame( ticks, delta );
+
+		// Presenting no longer slows the game thread down, so it's held at the frame rate limit instead
+		if ( RenderThread::IsRunning() )
+			DoFPSDelay( ticks );
 	}
+
+	netManager.Flush();
+}
+void GameManager::PushEvent( const SDL_Event &event )
+{
+	std::lock_guard< std::mutex > lock( eventMutex );
+	eventQueue.push_back( event );
+}
+bool GameManager::PollEvent( SDL_Event &event )
+{
+	if ( !RenderThread::IsRunning() )
+		return SDL_PollEvent( &event ) != 0;
+
+	std::lock_guard< std::mutex > lock( eventMutex );
+
+	if ( eventQueue.empty() )
+		return false;
+
+	event = eventQueue.front();
+	eventQueue.pop_front();
+
+	return true;
 }
 void GameManager::CheckForGameStateChange( )
 {
@@ -855,7 +1103,7 @@ bool GameManager::CheckGameLobbyChange( )
 {
 	if ( menuManager.GetGameState() == GameState::Lobby )
 	{
-		if ( !netManager.IsConnectedToGameServer() )
+		if ( !CheckConnection( true ) )
 		{
 			menuManager.SetGameState( GameState::MainMenu );
 			SDL_ShowSimpleMessageBox( SDL_MESSAGEBOX_ERROR, "Connection Error", "Could not connect to main server", NULL );
@@ -878,6 +1126,9 @@ void GameManager::HandleEvent( const SDL_Event &event )
 	} else if ( event.type == SDL_WINDOWEVENT)
 	{
 		//if ( SDL_WINDOWEVENT_LEAVE ) renderer.ForceMouseFocus();
+	} else if ( event.type == SDL_RENDER_TARGETS_RESET )
+	{
+		renderer.InvalidateTileLayer();
 	} else if ( event.type == SDL_QUIT )
 	{
 		menuManager.SetGameState( GameState::Quit );
@@ -894,7 +1145,7 @@ void GameManager::HandleMouseEvent(  const SDL_MouseButtonEvent &buttonEvent )
 {
 	if ( menuManager.GetGameState() == GameState::InGame && !isAIControlled )
 	{
-		physicsManager.SetLocalPaddlePosition( buttonEvent.x );
+		physicsManager.SetLocalPaddlePosition( renderer.GetViewTransform().ToField( Vector2f( buttonEvent.x, buttonEvent.y ) ).x );
 
 		if ( buttonEvent.type == SDL_MOUSEBUTTONDOWN )
 		{
@@ -943,7 +1194,22 @@ void GameManager::HandleJoystickEvent( const SDL_JoyButtonEvent &event )
 }
 void GameManager::UpdateJoystick( )
 {
-	DirectionX dirX = GetJoystickDirection( 0 );
+	DirectionX dirX = DirectionX::Middle;
+
+	if ( replayPlayer.IsPlaying() )
+	{
+		int8_t direction = 0;
+		if ( replayPlayer.IsNext( ReplayRecordType::Joystick ) && replayPlayer.ReadJoystick( direction ) )
+			dirX = static_cast< DirectionX > ( direction );
+	}
+	else
+	{
+		dirX = GetJoystickDirection( 0 );
+
+		if ( dirX != DirectionX::Middle )
+			replayRecorder.RecordJoystick( static_cast< int8_t > ( dirX ) );
+	}
+
 	DoJoystickMovement( dirX );
 }
 DirectionX GameManager::GetJoystickDirection( int32_t axis )
@@ -961,14 +1227,14 @@ void GameManager::DoJoystickMovement( const DirectionX &dirX )
 	if ( dirX == DirectionX::Right )
 	{
 		localPaddle->rect.x += 10;
-		if ( localPaddle->rect.x > windowSize.w )
+		if ( localPaddle->rect.x > field.w )
 			localPaddle->rect.x = 0;
 	}
 	else if ( dirX == DirectionX::Left )
 	{
 		localPaddle->rect.x -= 10;
 		if ( localPaddle->rect.x < 0 )
-			localPaddle->rect.x = windowSize.w;
+			localPaddle->rect.x = field.w;
 	}
 }
 void GameManager::HandleMenuKeys( const SDL_Event &event )
@@ -1042,13 +1308,10 @@ void GameManager::HandleGameKeys( const SDL_Event &event )
 }
 void GameManager::DoFPSDelay( unsigned int ticks )
 {
-	unsigned int diff = SDL_GetTicks() - ticks;
-	unsigned short delay = static_cast< unsigned short > ( ( frameDuration  - diff  ) + 0.5 );
+	double diff = static_cast< double > ( SDL_GetTicks() - ticks );
 
-	if ( diff < fpsLimit )
-	{
-		SDL_Delay( delay );
-	}
+	if ( diff < frameDuration )
+		SDL_Delay( static_cast< uint32_t > ( ( frameDuration - diff ) + 0.5 ) );
 }
 
 void GameManager::IncreaseBallSpeedFastMode( const Player &player, double delta )
@@ -1081,14 +1344,24 @@ void GameManager::Update( double delta )
 	{
 		UpdateLobbyState();
 
-		renderer.Render( );
+		if ( !isHeadless )
+			renderer.Render( );
 		return;
 	}
 
 	IsGameOVer();
-	AIMove();
-	UpdateGameObjects( delta );
-	renderer.Render( );
+	AIMove( delta );
+
+	if ( ballStorm.IsRunning() )
+		UpdateBallStorm( delta );
+	else
+	{
+		UpdateGameObjects( delta );
+
+		if ( !isHeadless )
+			renderer.Render( );
+	}
+
 	UpdateBoard();
 }
 void GameManager::UpdateGameObjects( double delta )
@@ -1096,6 +1369,54 @@ void GameManager::UpdateGameObjects( double delta )
 	UpdateBalls( delta );
 	UpdateBullets( delta );
 	UpdateBonusBoxes( delta );
+
+	RemoveDeadPieces();
+}
+void GameManager::UpdateBallStorm( double delta )
+{
+	SpawnBallStormBalls();
+	physicsManager.ResetCollisionTestCount();
+
+	auto start = std::chrono::steady_clock::now();
+
+	UpdateGameObjects( delta );
+
+	auto updated = std::chrono::steady_clock::now();
+
+	// There's no render thread during a ball storm, so this records and draws the frame
+	if ( !isHeadless )
+		renderer.Render( );
+
+	std::chrono::duration< double > updateTime = updated - start;
+	std::chrono::duration< double > renderTime = std::chrono::steady_clock::now() - updated;
+
+	ballStorm.AddFrame( updateTime.count(), renderTime.count(), physicsManager.GetCollisionTestCount() );
+
+	if ( ballStorm.IsRunning() )
+		return;
+
+	ballStorm.WriteCSV( "ballstorm.csv" );
+	logger->Log( __FILE__, __LINE__, "Ball storm done, results written to ballstorm.csv" );
+
+	runGame = false;
+}
+void GameManager::SpawnBallStormBalls()
+{
+	if ( localPlayerInfo.activeBalls >= ballStorm.GetBallCount() || !CanPlayerFireBall( Player::Local ) )
+		return;
+
+	// Like AddBall, but without a spawn message and a new ball count texture for every ball
+	while ( localPlayerInfo.activeBalls < ballStorm.GetBallCount() )
+	{
+		std::shared_ptr< Ball > ball = physicsManager.CreateBall( Player::Local, 0, GetBallSpeed( Player::Local ) );
+
+		ballList.push_back( ball );
+		renderer.AddBall( ball );
+
+		++localPlayerInfo.activeBalls;
+	}
+
+	renderer.RenderBallCount( localPlayerInfo.activeBalls, Player::Local );
 }
 void GameManager::UpdateBoard()
 {
@@ -1140,7 +1461,9 @@ void GameManager::StartNewGame()
 	messageSender.SendNewGameMessage( ip, port, localPlayerInfo.name );
 	menuManager.SetGameState( GameState::InGameWait );
 	netManager.SetIsServer( true );
-	netManager.Connect( ip, port );
+
+	if ( !replayPlayer.IsPlaying() )
+		netManager.Connect( ip, port );
 
 	Restart();
 
@@ -1157,7 +1480,9 @@ void GameManager::JoinGame()
 	gameID = gameInfo.GetGameID();
 
 	netManager.SetIsServer( false );
-	netManager.Connect( gameInfo.GetIP(), static_cast< uint16_t > ( gameInfo.GetPort()  ) );
+
+	if ( !replayPlayer.IsPlaying() )
+		netManager.Connect( gameInfo.GetIP(), static_cast< uint16_t > ( gameInfo.GetPort()  ) );
 
 	Restart();
 	messageSender.SendJoinGameMessage( gameInfo.GetGameID() );
@@ -1167,79 +1492,20 @@ void GameManager::UpdateGameList()
 	renderer.ClearGameList();
 	messageSender.SendGetGameListMessage();
 }
-void GameManager::AIMove()
+void GameManager::AIMove( double delta )
 {
 	if ( !isAIControlled )
 		return;
 
-	physicsManager.AIMove();
+	physicsManager.AIMove( Player::Local, delta );
 
 	messageSender.SendPaddlePosMessage( localPaddle->rect.x );
 }
-void GameManager::CheckBallTileIntersection( std::shared_ptr< Ball > ball )
-{
-	std::shared_ptr< Tile > closestTile = physicsManager.FindClosestIntersectingTile( ball );
-	RemoveClosestTile( ball, closestTile );
-}
-void GameManager::RemoveClosestTile( std::shared_ptr< Ball > ball, std::shared_ptr< Tile > tile )
-{
-	if ( !tile || !ball->TileCheck( tile->rect, IsSuperBall( ball )) )
-		return;
-
-	if ( ball->GetOwner() == Player::Local )
-		messageSender.SendBallDataMessage( ball, windowSize.h );
-
-	renderer.GenerateParticleEffect( tile );
-
-	if ( localPlayerInfo.IsBonusActive( BonusType::SuperBall ) )
-		tile->Kill();
-	else
-		tile->Hit();
-
-	UpdateTileHit( ball, tile );
-}
-void GameManager::UpdateTileHit( std::shared_ptr< Ball > ball, std::shared_ptr< Tile > tile )
-{
-	int32_t count = 1;
-	if (tile->GetTileType() == TileType::Explosive )
-		count = HandleExplosions( tile, ball->GetOwner() );
-	else
-	{
-		messageSender.SendTileHitMessage( tile->GetObjectID() );
-		renderer.UpdateTileHit( tile );
-		IncrementPoints( tile->GetTileType(), !tile->IsAlive(), ball->GetOwner() );
-	}
-
-	AddBonusBox( ball, tile->rect.x, tile->rect.y, count );
-}
-int GameManager::HandleExplosions( std::shared_ptr< Tile > explodingTile, Player ballOwner )
-{
-	std::vector< Rect > rectVec = physicsManager.GenereateExplosionRects( explodingTile );
-
-	int countDestroyedTiles = 0;
-
-	const auto &isDeadFunc = [=, &countDestroyedTiles ]( const std::shared_ptr< Tile > &curr )
-	{
-		if ( !RectHelpers::CheckTileIntersection( rectVec, curr->rect) )
-			return;
-
-		IncrementPoints( curr->GetTileType(), true, ballOwner );
-		messageSender.SendTileHitMessage( curr->GetObjectID(), true );
-		renderer.GenerateParticleEffect( curr );
-		++countDestroyedTiles;
-		curr->Kill();
-	};
-
-	// Loop throug all and apply isDeadFunc
-	std::for_each( tileList.begin(), tileList.end(), isDeadFunc );
-
-	return countDestroyedTiles;
-}
 void GameManager::UpdateBonusBoxes( double delta )
 {
 	for ( const auto &p  : bonusBoxList )
 	{
-		if ( p->GetOwner() == Player::Local &&  p->rect.CheckTileIntersection( localPaddle->rect ) )
+		if ( p->GetOwner() == Player::Local && p->IsAlive() && p->rect.CheckTileIntersection( localPaddle->rect ) )
 		{
 			messageSender.SendBonusBoxPickupMessage( p->GetObjectID() );
 			ApplyBonus( p );
@@ -1247,25 +1513,6 @@ void GameManager::UpdateBonusBoxes( double delta )
 	}
 
 	physicsManager.MoveBonusBoxes ( delta );
-	RemoveDeadBonusBoxes();
-}
-void GameManager::RemoveDeadBonusBoxes()
-{
-	auto isDeadFunc = [=]( std::shared_ptr< BonusBox > curr )
-	{
-		if ( curr->IsAlive() )
-			return false;
-
-		renderer.RemoveBonusBox( curr );
-		physicsManager.RemoveBonusBox( curr );
-
-		return true;
-	};
-
-	auto newEnd = std::remove_if( bonusBoxList.begin(), bonusBoxList.end(), isDeadFunc );
-
-	// Remove item returned by remove_if
-	bonusBoxList.erase( newEnd, bonusBoxList.end( ) );
 }
 void GameManager::ApplyBonus( std::shared_ptr< BonusBox > ptr )
 {
@@ -1288,13 +1535,13 @@ void GameManager::ApplyBonus( std::shared_ptr< BonusBox > ptr )
 			{
 				renderer.RenderText( "Extension", Player::Local, true  );
 
-				if ( localPaddle->rect.w < ( windowSize.w * 0.45 ) )
-					localPaddle->rect.w += ( windowSize.w * 0.025 );
+				if ( localPaddle->rect.w < ( field.w * 0.45 ) )
+					localPaddle->rect.w += ( field.w * 0.025 );
 			}
 			else
 			{
-				if ( remotePaddle->rect.w > ( windowSize.w * 0.45) )
-					remotePaddle->rect.w += ( windowSize.w * 0.025 );
+				if ( remotePaddle->rect.w > ( field.w * 0.45) )
+					remotePaddle->rect.w += ( field.w * 0.025 );
 			}
 			break;
 		case BonusType::ShrinkPaddle:
@@ -1302,13 +1549,13 @@ void GameManager::ApplyBonus( std::shared_ptr< BonusBox > ptr )
 			{
 				renderer.RenderText( "Shrink", Player::Local, true  );
 
-				if ( localPaddle->rect.w > ( windowSize.w * 0.04 ) )
-					localPaddle->rect.w -= ( windowSize.w * 0.025 );
+				if ( localPaddle->rect.w > ( field.w * 0.04 ) )
+					localPaddle->rect.w -= ( field.w * 0.025 );
 			}
 			else
 			{
-				if ( remotePaddle->rect.w > ( windowSize.w * 0.04 ) )
-					remotePaddle->rect.w -= ( windowSize.w * 0.025 );
+				if ( remotePaddle->rect.w > ( field.w * 0.04 ) )
+					remotePaddle->rect.w -= ( field.w * 0.025 );
 			}
 			break;
 		case BonusType::SuperBall:
@@ -1377,7 +1624,7 @@ void GameManager::ApplyBonus_BallSplit( )
 		newBall->SetDirection( dir );
 		newBall->SetSpeed( p->GetSpeed() );
 		newBall->SetPosition( p->GetPosition() );
-		messageSender.SendBallSpawnMessage( newBall, windowSize.h );
+		messageSender.SendBallSpawnMessage( newBall );
 
 		ballList.push_back( newBall);
 		renderer.AddBall( newBall);
@@ -1399,8 +1646,7 @@ void GameManager::ApplyBonus_Death( const Player &player )
 	renderer.RenderText( "Death!!", Player::Local, true );
 	localPlayerInfo.RemoveAllBonuses();
 
-	if ( physicsManager.KillAllBallsWithOwner( player ) )
-		DeleteDeadBalls();
+	physicsManager.KillAllBallsWithOwner( player );
 
 	renderer.RenderLives( localPlayerInfo.lives, Player::Local );
 }
@@ -1451,9 +1697,21 @@ void GameManager::GenerateBoard()
 	if ( !CanGenerateNewBoard() )
 		return;
 
-	Board b = boardLoader.GenerateBoard( windowSize );
+	Board b = boardFile.empty() ? boardLoader.GenerateBoard( field ) : boardLoader.GenerateBoard( boardFile, field );
 	std::vector<TilePosition> vec = b.GetTiles();
 
+	// The board files might have changed since the game was recorded, so replays use the recorded tiles
+	if ( replayPlayer.IsPlaying() )
+	{
+		if ( !replayPlayer.ReadBoard( b.levelName, vec ) )
+		{
+			ReplayDesynced( "Expected a board", true );
+			return;
+		}
+	}
+	else
+		replayRecorder.RecordBoard( b.levelName, vec );
+
 	SetLevelName( b.levelName );
 
 	for ( const auto &tile : vec )
@@ -1480,9 +1738,9 @@ void GameManager::ClearBoard()
 	{
 		ball->SetSpeed( 0.0 );
 		if ( ball->GetOwner() == Player::Local )
-			ball->SetPosition( Vector2f( ( windowSize.w / 2 ) - ( ball->rect.w ), localPaddle->rect.y - ( ball->rect.h * 2 ) ) );
+			ball->SetPosition( Vector2f( ( field.w / 2 ) - ( ball->rect.w ), localPaddle->rect.y - ( ball->rect.h * 2 ) ) );
 		else
-			ball->SetPosition( Vector2f( ( windowSize.w / 2 ) - ( ball->rect.w ), remotePaddle->rect.y +  remotePaddle->rect.h + ( ball->rect.h * 2 ) ) );
+			ball->SetPosition( Vector2f( ( field.w / 2 ) - ( ball->rect.w ), remotePaddle->rect.y +  remotePaddle->rect.h + ( ball->rect.h * 2 ) ) );
 	}
 	physicsManager.Clear();
 	renderer.ClearBoard();
@@ -1491,7 +1749,10 @@ void GameManager::ClearBoard()
 std::string GameManager::StripLevelName( std::string levelName )
 {
 	levelName = levelName.substr( levelName.find_last_of( '/' ) + 1, levelName.size() );
-	levelName = levelName.substr( 0, levelName.size() - 4 );
+
+	// Generated boards have no .txt
+	if ( levelName.size() > 4 && levelName.compare( levelName.size() - 4, 4, ".txt" ) == 0 )
+		levelName = levelName.substr( 0, levelName.size() - 4 );
 
 	return levelName;
 }
@@ -1502,50 +1763,9 @@ void GameManager::SetLevelName( const std::string &levelName_ )
 	renderer.RenderLevelName( levelName );
 	messageSender.SendLevelNameMessage( levelName );
 }
-void GameManager::IncrementPoints( const TileType &tileType, bool isDestroyed, const Player &ballOwner )
-{
-	double pointIncrease = gameConfig.Get( ConfigValueType::PointsHit );
-
-	if ( isDestroyed )
-		pointIncrease += gameConfig.GetTilePoints( tileType );
-
-	if ( ballOwner == Player::Local )
-	{
-		localPlayerInfo.points += pointIncrease;
-		renderer.RenderPoints   ( localPlayerInfo.points, ballOwner );
-	}
-	else
-	{
-		remotePlayerInfo.points += pointIncrease;
-		renderer.RenderPoints( remotePlayerInfo.points, ballOwner );
-	}
-}
-void GameManager::ReducePlayerLifes( Player player )
-{
-	LoadConfig();
-
-	if ( player == Player::Local )
-	{
-		localPlayerInfo.ReduceLifes();
-
-		if ( localPlayerInfo.lives == 0 )
-			physicsManager.KillBallsAndBonusBoxes( Player::Local );
-
-		renderer.RenderLives( localPlayerInfo.lives, Player::Local );
-	}
-	else
-	{
-		remotePlayerInfo.ReduceLifes();
-
-		if ( remotePlayerInfo.lives == 0 )
-			physicsManager.KillBallsAndBonusBoxes( Player::Remote );
-
-		renderer.RenderLives( remotePlayerInfo.lives, Player::Local );
-	}
-}
 bool GameManager::IsLevelDone()
 {
-	if ( physicsManager.CountAllTiles() == 0 || ( !AnyFastModeActive() && physicsManager.CountDestroyableTiles() == 0 ) )
+	if ( gameRules.IsLevelDone() )
 	{
 		ClearBoard();
 		return true;
@@ -1554,7 +1774,7 @@ bool GameManager::IsLevelDone()
 }
 void GameManager::IsGameOVer()
 {
-	if ( localPlayerInfo.lives == 0 && remotePlayerInfo.lives == 0 )
+	if ( gameRules.IsGameOver() )
 		menuManager.SetGameState( GameState::GameOver );
 }
 bool GameManager::CanGenerateNewBoard()
@@ -1565,7 +1785,7 @@ bool GameManager::CanGenerateNewBoard()
 		return false;
 	}
 
-	if ( boardLoader.IsLastLevel() )
+	if ( boardFile.empty() && boardLoader.IsLastLevel() )
 	{
 		logger->Log( __FILE__, __LINE__, "================== No more levels ===================" );
 		menuManager.SetGameState( GameState::GameOver );
@@ -1586,17 +1806,34 @@ void GameManager::CheckBallSpeedFastMode( double delta )
 	if ( remotePlayerInfo.IsBonusActive( BonusType::SuperBall ) && remotePlayerInfo.IsBonusActive( BonusType::FireBullets ) )
 		IncreaseBallSpeedFastMode( Player::Remote, delta );
 }
-bool GameManager::IsSuperBall( std::shared_ptr< Ball > ball )
-{
-	if ( ball->GetOwner() == Player::Local )
-		return localPlayerInfo.IsBonusActive( BonusType::SuperBall );
-	else
-		return remotePlayerInfo.IsBonusActive( BonusType::SuperBall );
-}
 void GameManager::SetAIControlled( bool isAIControlled_ )
 {
 	isAIControlled = isAIControlled_;
 }
+void GameManager::SetUseRenderThread( bool useRenderThread_ )
+{
+	useRenderThread = useRenderThread_;
+}
+void GameManager::SetBoard( const std::string &boardFile_ )
+{
+	boardFile = boardFile_;
+}
+void GameManager::SetBallStorm( uint32_t maxBalls )
+{
+	ballStorm.Start( maxBalls, 300 );
+
+	if ( useRenderThread && !isHeadless )
+		std::cout << "Ball storm : render thread turned off, render_ms is the time it takes to record and draw a frame" << std::endl;
+}
+void GameManager::SetUseUDP( bool useUDP )
+{
+	netManager.SetUseUDP( useUDP );
+}
+void GameManager::OverrideConfig( ConfigValueType config, double value )
+{
+	configOverrides.push_back( std::make_pair( config, value ) );
+	gameConfig.Set( value, config );
+}
 void GameManager::SetFPSLimit( unsigned short limit )
 {
 	fpsLimit  = limit;
@@ -1605,3 +1842,186 @@ void GameManager::SetFPSLimit( unsigned short limit )
 	else
 		frameDuration = 0.0;
 }
+// Replay
+// ===========================================================================
+void GameManager::InitReplay()
+{
+	if ( replayPlayer.IsPlaying() )
+	{
+		const ReplayHeader &header = replayPlayer.GetHeader();
+
+		randomService.Seed( header.seed );
+
+		for ( const auto &p : header.configValues )
+			gameConfig.Set( p.second, p.first );
+
+		for ( const auto &p : header.points )
+			gameConfig.SetTilePoints( p.first, p.second );
+
+		gameConfig.SetFastMode( header.fastMode );
+		LoadConfig();
+
+		SetAIControlled( header.isAIControlled );
+		netManager.SetUseUDP( false );
+
+		logger->Log( __FILE__, __LINE__, "Replaying game with seed", header.seed );
+		return;
+	}
+
+	ReplayHeader header;
+	header.seed = RandomService::GenerateSeed();
+
+	randomService.Seed( header.seed );
+
+	if ( recordFile.empty() )
+		return;
+
+	header.width = windowSize.w;
+	header.height = windowSize.h;
+	header.isAIControlled = isAIControlled;
+	header.fastMode = gameConfig.GetFastMode();
+	header.configValues = gameConfig.GetValues();
+	header.points = gameConfig.GetPoints();
+
+	replayRecorder.Start( recordFile, header );
+}
+bool GameManager::ReadReplayFrame( double &delta )
+{
+	if ( !replayPlayer.ReadTick( delta, gameTicks ) )
+	{
+		if ( !replayPlayer.IsNext( ReplayRecordType::End ) )
+			ReplayDesynced( "Expected a new frame", true );
+
+		return false;
+	}
+
+	SDL_Event event;
+	while ( replayPlayer.ReadEvent( event ) )
+		HandleEvent( event );
+
+	// Only closing the window is handled, the rest of the input comes from the replay
+	while ( SDL_PollEvent( &event ) )
+	{
+		if ( event.type == SDL_QUIT )
+			runGame = false;
+	}
+
+	return true;
+}
+void GameManager::EndFrame( unsigned int frameStart, double delta )
+{
+	if ( replayPlayer.IsPlaying() )
+	{
+		uint32_t checksum = 0;
+
+		if ( !replayPlayer.ReadChecksum( checksum ) )
+			ReplayDesynced( "Expected end of frame", true );
+		else if ( checksum != GetStateChecksum() )
+			ReplayDesynced( "Game state differs from the recorded game", false );
+
+		// Rendered replays run at the same speed as the recorded game, headless ones as fast as possible
+		unsigned int frameTime = SDL_GetTicks() - frameStart;
+		unsigned int recordedTime = static_cast< unsigned int > ( delta * 1000.0 );
+
+		if ( !isHeadless && recordedTime > frameTime )
+			SDL_Delay( recordedTime - frameTime );
+
+		return;
+	}
+
+	if ( !replayRecorder.IsRecording() )
+		return;
+
+	replayRecorder.RecordChecksum( GetStateChecksum() );
+	replayRecorder.EndTick();
+}
+void GameManager::ReadReplayMessages()
+{
+	while ( replayPlayer.ReadMessage( messageParser ) )
+	{
+		while ( messageParser.ParseNext( recievedMessage ) )
+			HandleRecieveMessage( recievedMessage );
+	}
+}
+// The connections aren't there when replaying, so the recorded state is used instead
+bool GameManager::CheckConnection( bool mainServer )
+{
+	if ( replayPlayer.IsPlaying() )
+	{
+		uint8_t state = 0;
+
+		if ( !replayPlayer.ReadNetState( state ) )
+			ReplayDesynced( "Expected connection state", true );
+
+		return state != 0;
+	}
+
+	bool isConnected = mainServer ? netManager.IsConnectedToGameServer() : netManager.IsConnected();
+
+	replayRecorder.RecordNetState( isConnected ? 1 : 0 );
+	return isConnected;
+}
+void GameManager::ReplayDesynced( const std::string &reason, bool stopReplay )
+{
+	if ( replayDesynced )
+		return;
+
+	std::stringstream ss;
+	ss << "Replay desynced at frame " << replayPlayer.GetTickCount() << " : " << reason;
+	logger->Log( __FILE__, __LINE__, ss.str() );
+
+	replayDesynced = true;
+
+	// Once the records are out of order, there is no way of getting back in sync
+	if ( stopReplay )
+		runGame = false;
+}
+void GameManager::PrintReplayResult( unsigned int duration ) const
+{
+	std::cout << "========== REPLAY ==========\n";
+	std::cout << "Frames           : " << replayPlayer.GetTickCount() << std::endl;
+	std::cout << "Time             : " << duration << " ms" << std::endl;
+	std::cout << "Desynced         : " << std::boolalpha << replayDesynced << std::endl;
+	std::cout << "Local points     : " << localPlayerInfo.points << std::endl;
+	std::cout << "Local lives      : " << localPlayerInfo.lives << std::endl;
+	std::cout << "Remote points    : " << remotePlayerInfo.points << std::endl;
+	std::cout << "Remote lives     : " << remotePlayerInfo.lives << std::endl;
+	std::cout << "Tiles left       : " << tileList.size() << std::endl;
+	std::cout << "============================\n";
+}
+uint32_t GameManager::GetStateChecksum() const
+{
+	// FNV-1a over what ends up on the screen. Doesn't need to be perfect, only change when the game goes a different way
+	uint32_t hash = 2166136261u;
+
+	auto add = [ &hash ]( uint64_t value )
+	{
+		for ( int i = 0; i < 8; ++i )
+		{
+			hash ^= static_cast< uint32_t > ( ( value >> ( i * 8 ) ) & 0xFF );
+			hash *= 16777619u;
+		}
+	};
+	auto addDouble = [ &add ]( double value )
+	{
+		uint64_t bits = 0;
+		memcpy( &bits, &value, sizeof( bits ) );
+		add( bits );
+	};
+
+	add( localPlayerInfo.points );
+	add( localPlayerInfo.lives );
+	add( remotePlayerInfo.points );
+	add( remotePlayerInfo.lives );
+	add( tileList.size() );
+
+	addDouble( localPaddle->rect.x );
+
+	for ( const auto &ball : ballList )
+	{
+		addDouble( ball->rect.x );
+		addDouble( ball->rect.y );
+	}
+
+	return hash;
+}
@@ -1,15 +1,29 @@
 #pragma once
 
+#include <mutex>
+#include <deque>
+
 #include "Timer.h"
 #include "Renderer.h"
 #include "NetManager.h"
 #include "BoardLoader.h"
 #include "MenuManager.h"
 #include "ConfigLoader.h"
+#include "GameRules.h"
 #include "MessageSender.h"
 #include "PhysicsManager.h"
 
+#include "math/RandomService.h"
+
 #include "structs/PlayerInfo.h"
+#include "structs/net/RemoteClock.h"
+#include "structs/net/TCPMessage.h"
+#include "structs/net/TCPMessageParser.h"
+
+#include "tools/ReplayPlayer.h"
+#include "tools/ReplayRecorder.h"
+#include "tools/BallStorm.h"
+#include "tools/ConfigWatcher.h"
 
 enum class DirectionX{ Left, Middle, Right };
 
@@ -24,18 +38,32 @@ struct Bullet;
 struct Paddle;
 struct Ball;
 struct Tile;
-class GameManager
+class GameManager : private GameRulesListener
 {
 	public:
 		GameManager();
 
 		// Startup options
+		// A replay has to be loaded before Init, since it decides the window size
+		bool LoadReplay( const std::string &fileName, bool headless );
+		void SetRecordFile( const std::string &fileName );
 		bool Init( const std::string &localPlayerName, const SDL_Rect &size, bool startFS );
 		void InitNetManager( std::string ip_, uint16_t port_ );
 
 		// Setters
 		void SetFPSLimit( unsigned short limit );
 		void SetAIControlled( bool isAIControlled_ );
+		void SetUseUDP( bool useUDP );
+		void SetUseRenderThread( bool useRenderThread_ );
+		// Every level is this board in boards/, instead of the next one in boardlist.txt
+		void SetBoard( const std::string &boardFile_ );
+		// Once a game starts, keeps more and more balls alive and measures the frame time, see BallStorm
+		// The results are written to ballstorm.csv and the game quits. Only meant for single player
+		// The render thread isn't used during a storm, so the render time includes drawing
+		void SetBallStorm( uint32_t maxBalls );
+
+		// Replaces a value read from Config.txt, used for the command line arguments
+		void OverrideConfig( ConfigValueType config, double value );
 
 		void Run();
 	private:
@@ -47,7 +75,6 @@ class GameManager
 		void AddBonusBox( const Player &owner, Vector2f dir,  const Vector2f &pos, int tilesDestroyed = 1 );
 		void RemoveBonusBox( std::shared_ptr< BonusBox >  bb );
 		void DeleteAllBonusBoxes();
-		void RemoveDeadBonusBoxes();
 
 		std::shared_ptr< BonusBox > GetBonusBoxFromID( int32_t ID );
 		void ApplyBonus( std::shared_ptr< BonusBox > ptr );
@@ -57,22 +84,17 @@ class GameManager
 
 		// Ball
 		// ===========================================
-		void UpdateTileHit( std::shared_ptr< Ball > ball, std::shared_ptr< Tile > tile );
 		void UpdateBallSpeed();
 		void IncreaseActiveBalls( const Player &player );
-		void ReduceActiveBalls( const Player &player, uint32_t ballID );
 		void CheckBallSpeedFastMode( double delta);
 		void IncreaseBallSpeedFastMode( const Player &player, double delta );
 
-		void DeleteDeadBalls();
 		void DeleteAllBalls();
 
 
 		void AddBall( );
 		std::shared_ptr<Ball> AddBall( Player owner, unsigned int ballID );
-		void RemoveBall( std::shared_ptr< Ball > ball );
 
-		bool IsSuperBall( std::shared_ptr< Ball > ball );
 		double GetBallSpeed( const Player &player ) const;
 		bool CanPlayerFireBall( const Player &player ) const;
 
@@ -82,26 +104,24 @@ class GameManager
 		void CheckBulletOutOfBounds( std::shared_ptr< Bullet > bullet );
 		void HandleBulletTileIntersection( std::shared_ptr< Bullet > bullet, std::shared_ptr< Tile > tile );
 
-		void DeleteDeadBullets( );
 		void DeleteAllBullets();
 		void FireBullets();
 		std::shared_ptr< Bullet >  FireBullet( int32_t id, const Player &owner, Vector2f pos );
 
 		bool IsSuperBullet( const Player owner ) const;
-		bool AnyFastModeActive() const;
 
 		// Tiles
 		// ==========================================
 		void AddTile( const Vector2f &pos, TileType tileType, int32_t tileID  );
-		void RemoveTile( std::shared_ptr< Tile > tile );
-		void DeleteDeadTiles();
-
-		void CheckBallTileIntersection( std::shared_ptr< Ball > ball );
-		void RemoveClosestTile( std::shared_ptr< Ball > ball, std::shared_ptr< Tile > closestTile );
 
 		// Config
 		// ===========================================
 		void LoadConfig();
+		void ApplyNetworkConditions();
+		// Applies what ConfigWatcher has picked up since the last frame
+		void ApplyConfigChanges();
+		// Only what differs from oldConfig is applied
+		void ApplyChangedConfig( const ConfigLoader &oldConfig );
 
 		// Joystick
 		// ==========================================
@@ -120,7 +140,7 @@ class GameManager
 
 		// AI
 		// ==========================================
-		void AIMove();
+		void AIMove( double delta );
 
 		// Menu
 		// ==========================================
@@ -134,10 +154,6 @@ class GameManager
 		void StartNewGame();
 		void JoinGame();
 
-		// Explotion related
-		// ===========================================
-		int HandleExplosions( std::shared_ptr< Tile > explodingTile, Player ballOwner  );
-
 		// Board handling
 		// ===========================================
 		void GenerateBoard();
@@ -146,10 +162,16 @@ class GameManager
 		std::string StripLevelName( std::string levelName );
 		void SetLevelName( const std::string &levelName );
 
-		// Points / Lives
+		// GameRules
 		// ===========================================
-		void IncrementPoints( const TileType &tileType, bool isDestroyed, const Player &ballOwner );
-		void ReducePlayerLifes( Player player );
+		// Draws what happened and sends it to the other player
+		void OnBallBounced( const std::shared_ptr< Ball > &ball );
+		void OnBallHitTile( const std::shared_ptr< Ball > &ball, const std::shared_ptr< Tile > &tile, int32_t tilesDestroyed );
+		void OnTileHit( const std::shared_ptr< Tile > &tile );
+		void OnTileExploded( const std::shared_ptr< Tile > &tile );
+		void OnPointsChanged( const Player &player, uint32_t points );
+		void OnBallLost( const std::shared_ptr< Ball > &ball );
+		void OnLifeLost( const Player &player );
 
 		// Update
 		// ===========================================
@@ -158,6 +180,10 @@ class GameManager
 		void UpdateBonusBoxes( double delta );
 		void UpdateBullets( double delta );
 		void UpdateBalls( double delta );
+		void UpdateBallStorm( double delta );
+		void SpawnBallStormBalls();
+		// End of the tick. Everything killed during it is removed from the game, physics and renderer at once
+		void RemoveDeadPieces();
 
 		void UpdateLobbyState();
 		void UpdateJoystick( );
@@ -174,6 +200,10 @@ class GameManager
 		void HandleGameKeys( const SDL_Event &event );
 		void HandleJoystickEvent( const SDL_JoyButtonEvent &event );
 
+		// Reads from SDL, or from the events the render thread has passed on
+		bool PollEvent( SDL_Event &event );
+		void PushEvent( const SDL_Event &event );
+
 		// Input
 		// ===========================================
 		void InitRenderer();
@@ -208,9 +238,31 @@ class GameManager
 		void RecieveBonusBoxPickupMessage( const TCPMessage &message );
 		void RecieveBulletFireMessage( const TCPMessage &message );
 		void RecieveBulletKillMessage( const TCPMessage &message );
+		void RecievePongMessage( const TCPMessage &message );
+
+		void SendPing();
+		void SendUDPHandshake();
+		void SendBallStateRefresh();
+		void ReadUnreliableMessages( );
 
 		void DoFPSDelay( unsigned int ticks );
 
+		// Main loop
+		// ===========================================
+		void RunWithRenderThread();
+		void RunGameLoop();
+
+		// Replay
+		// ===========================================
+		void InitReplay();
+		bool ReadReplayFrame( double &delta );
+		void EndFrame( unsigned int frameStart, double delta );
+		void ReadReplayMessages();
+		bool CheckConnection( bool mainServer );
+		void ReplayDesynced( const std::string &reason, bool stopReplay );
+		void PrintReplayResult( unsigned int duration ) const;
+		uint32_t GetStateChecksum() const;
+
 		// Rendering
 		// ===========================================
 		void RendererScores();
@@ -229,6 +281,8 @@ class GameManager
 		NetManager netManager;
 		MessageSender messageSender;
 		PhysicsManager physicsManager;
+		// Only the local player's balls are moved by it, the remote ones are predicted between ball data messages
+		GameRules gameRules;
 		Logger* logger;
 
 		bool runGame;
@@ -247,12 +301,53 @@ class GameManager
 		std::vector< std::shared_ptr< BonusBox > > bonusBoxList;
 		std::vector< std::shared_ptr< Bullet   > > bulletList;
 
+		// Kept between ticks, so it doesn't have to allocate every time something dies
+		DeadPieces deadPieces;
+
 		SDL_Rect windowSize;
-		double remoteResolutionScale;
+		// What everything is played on, the Renderer scales it to windowSize
+		SDL_Rect field;
+
+		RemoteClock remoteClock;
+		uint32_t lastPingSent;
+
+		bool udpHandshakeSent;
+		uint32_t lastBallStateRefresh;
+
+		// Reused for every recieved message
+		TCPMessageParser messageParser;
+		TCPMessage recievedMessage;
+
+		// Replays
+		ReplayPlayer replayPlayer;
+		ReplayRecorder replayRecorder;
+		std::string recordFile;
+		bool isHeadless;
+		bool replayDesynced;
+
+		// Made current on the thread that runs the game, so the game uses the seed in the replay header
+		RandomService randomService;
+
+		// Time of the current frame, recorded so that replays see the same time as the recorded game
+		uint32_t gameTicks;
 
 		unsigned short fpsLimit;
 		double frameDuration;
 
+		// Events read by the render thread, waiting for the game thread
+		bool useRenderThread;
+		std::mutex eventMutex;
+		std::deque< SDL_Event > eventQueue;
+
+		std::string boardFile;
+		BallStorm ballStorm;
+
+		// Not used for replays or when recording, those need the config to stay the same for the whole game
+		ConfigWatcher configWatcher;
+		ConfigChanges configChanges;
+		// From the command line, set again when Config.txt is reloaded
+		std::vector< std::pair< ConfigValueType, double > > configOverrides;
+
 		SDL_Joystick *stick;
 		bool respawnBalls;
 };
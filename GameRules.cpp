@@ -0,0 +1,255 @@
+#include "GameRules.h"
+
+#include "structs/game_objects/Ball.h"
+#include "structs/game_objects/Tile.h"
+#include "structs/game_objects/Paddle.h"
+#include "structs/game_objects/Graveyard.h"
+
+#include "structs/PlayerInfo.h"
+
+#include "enums/Player.h"
+#include "enums/BonusType.h"
+#include "enums/ConfigValueType.h"
+
+#include "ConfigLoader.h"
+#include "PhysicsManager.h"
+
+GameRulesListener::~GameRulesListener()
+{
+}
+void GameRulesListener::OnBallBounced( const std::shared_ptr< Ball > & )
+{
+}
+void GameRulesListener::OnBallHitTile( const std::shared_ptr< Ball > &, const std::shared_ptr< Tile > &, int32_t )
+{
+}
+void GameRulesListener::OnTileHit( const std::shared_ptr< Tile > & )
+{
+}
+void GameRulesListener::OnTileExploded( const std::shared_ptr< Tile > & )
+{
+}
+void GameRulesListener::OnPointsChanged( const Player &, uint32_t )
+{
+}
+void GameRulesListener::OnBallLost( const std::shared_ptr< Ball > & )
+{
+}
+void GameRulesListener::OnLifeLost( const Player & )
+{
+}
+GameRules::GameRules( PhysicsManager &physicsManager_, const ConfigLoader &config_, PlayerInfo &localPlayerInfo_, PlayerInfo &remotePlayerInfo_ )
+	:	physicsManager( physicsManager_ )
+	,	config( config_ )
+	,	localPlayerInfo( localPlayerInfo_ )
+	,	remotePlayerInfo( remotePlayerInfo_ )
+	,	localPaddle()
+	,	remotePaddle()
+	,	noListener()
+	,	listener( &noListener )
+	,	windowSize()
+	,	playsBothPlayers( false )
+	,	isIndestructible( false )
+{
+}
+void GameRules::SetListener( GameRulesListener* listener_ )
+{
+	listener = ( listener_ != nullptr ) ? listener_ : &noListener;
+}
+void GameRules::SetWindowSize( const SDL_Rect &windowSize_ )
+{
+	windowSize = windowSize_;
+}
+void GameRules::SetPaddles( const std::shared_ptr< Paddle > &localPaddle_, const std::shared_ptr< Paddle > &remotePaddle_ )
+{
+	localPaddle = localPaddle_;
+	remotePaddle = remotePaddle_;
+}
+void GameRules::SetPlaysBothPlayers( bool playsBothPlayers_ )
+{
+	playsBothPlayers = playsBothPlayers_;
+}
+void GameRules::SetIndestructible( bool isIndestructible_ )
+{
+	isIndestructible = isIndestructible_;
+}
+void GameRules::UpdateBalls( const std::vector< std::shared_ptr< Ball > > &ballList, double delta )
+{
+	for ( const auto &p : ballList )
+		p->Update( delta );
+
+	UpdatePlayerBalls( ballList, Player::Local );
+
+	if ( playsBothPlayers )
+		UpdatePlayerBalls( ballList, Player::Remote );
+	else
+		PredictBalls( ballList, Player::Remote, delta );
+}
+void GameRules::UpdatePlayerBalls( const std::vector< std::shared_ptr< Ball > > &ballList, const Player &owner )
+{
+	// Picked once here, instead of looking up the bonus for every tile hit
+	if ( GetPlayerInfo( owner ).IsBonusActive( BonusType::SuperBall ) )
+		UpdateBallCollisions< true >( ballList, owner );
+	else
+		UpdateBallCollisions< false >( ballList, owner );
+}
+template < bool isSuperBall >
+void GameRules::UpdateBallCollisions( const std::vector< std::shared_ptr< Ball > > &ballList, const Player &owner )
+{
+	const auto &paddle = ( owner == Player::Local ) ? localPaddle : remotePaddle;
+
+	for ( const auto &p : ballList )
+	{
+		// Killed earlier this tick, removed at the end of it
+		if ( p->GetOwner() != owner || !p->IsAlive() )
+			continue;
+
+		if ( p->BoundCheck( windowSize ) || p->PaddleCheck( paddle->rect ) )
+		{
+			listener->OnBallBounced( p );
+			continue;
+		}
+
+		CheckBallTileIntersection< isSuperBall >( p );
+
+		// DeathCheck serves the ball again
+		if ( p->DeathCheck( windowSize ) && !isIndestructible )
+			p->Kill();
+	}
+}
+template < bool isSuperBall >
+void GameRules::CheckBallTileIntersection( const std::shared_ptr< Ball > &ball )
+{
+	std::shared_ptr< Tile > tile = physicsManager.FindClosestIntersectingTile( ball );
+
+	if ( !tile || !ball->TileCheck< isSuperBall >( tile->rect ) )
+		return;
+
+	listener->OnBallBounced( ball );
+
+	if ( isIndestructible )
+	{
+		// The tile is still there next frame, so a normal ball backs out of it instead of getting stuck
+		if ( !isSuperBall )
+		{
+			ball->rect.x = ball->oldRect.x;
+			ball->rect.y = ball->oldRect.y;
+		}
+
+		listener->OnBallHitTile( ball, tile, 0 );
+		return;
+	}
+
+	int32_t tilesDestroyed = HitTile( tile, ball->GetOwner(), isSuperBall );
+
+	listener->OnBallHitTile( ball, tile, tilesDestroyed );
+}
+void GameRules::PredictBalls( const std::vector< std::shared_ptr< Ball > > &ballList, const Player &owner, double delta )
+{
+	for ( const auto &p : ballList )
+	{
+		if ( p->GetOwner() != owner || !p->IsAlive() )
+			continue;
+
+		p->ApplyCorrection( delta );
+		p->BoundCheck( windowSize );
+	}
+}
+int32_t GameRules::HitTile( const std::shared_ptr< Tile > &tile, const Player &owner, bool kill )
+{
+	if ( kill )
+		tile->Kill();
+	else
+		tile->Hit();
+
+	if ( tile->GetTileType() == TileType::Explosive )
+		return HandleExplosions( tile, owner );
+
+	IncrementPoints( tile->GetTileType(), !tile->IsAlive(), owner );
+	listener->OnTileHit( tile );
+
+	return 1;
+}
+int32_t GameRules::HandleExplosions( const std::shared_ptr< Tile > &explodingTile, const Player &owner )
+{
+	int32_t tilesDestroyed = 0;
+
+	for ( const auto &tile : physicsManager.FindExplodedTiles( explodingTile ) )
+	{
+		IncrementPoints( tile->GetTileType(), true, owner );
+		listener->OnTileExploded( tile );
+
+		tile->Kill();
+		++tilesDestroyed;
+	}
+
+	return tilesDestroyed;
+}
+void GameRules::IncrementPoints( TileType tileType, bool isDestroyed, const Player &owner )
+{
+	double pointIncrease = config.Get( ConfigValueType::PointsHit );
+
+	if ( isDestroyed )
+		pointIncrease += config.GetTilePoints( tileType );
+
+	PlayerInfo &info = GetPlayerInfo( owner );
+	info.points += static_cast< uint32_t > ( pointIncrease );
+
+	listener->OnPointsChanged( owner, info.points );
+}
+bool GameRules::TakeDeadPieces( DeadPieces &dead )
+{
+	if ( !physicsManager.TakeDeadPieces( dead ) )
+		return false;
+
+	for ( const auto &ball : dead.balls )
+		ReduceActiveBalls( ball );
+
+	return true;
+}
+void GameRules::ReduceActiveBalls( const std::shared_ptr< Ball > &ball )
+{
+	PlayerInfo &info = GetPlayerInfo( ball->GetOwner() );
+	--info.activeBalls;
+
+	if ( info.activeBalls == 0 )
+		ReducePlayerLifes( ball->GetOwner() );
+
+	listener->OnBallLost( ball );
+}
+void GameRules::ReducePlayerLifes( const Player &player )
+{
+	PlayerInfo &info = GetPlayerInfo( player );
+	info.ReduceLifes();
+
+	if ( info.lives == 0 )
+		physicsManager.KillBallsAndBonusBoxes( player );
+
+	listener->OnLifeLost( player );
+}
+bool GameRules::IsLevelDone() const
+{
+	return physicsManager.CountAllTiles() == 0 || ( !AnyFastModeActive() && physicsManager.CountDestroyableTiles() == 0 );
+}
+bool GameRules::IsGameOver() const
+{
+	return localPlayerInfo.lives == 0 && remotePlayerInfo.lives == 0;
+}
+bool GameRules::AnyFastModeActive() const
+{
+	return ( localPlayerInfo.IsBonusActive( BonusType::SuperBall ) || remotePlayerInfo.IsBonusActive( BonusType::SuperBall ) );
+}
+PlayerInfo &GameRules::GetPlayerInfo( const Player &player )
+{
+	if ( player == Player::Local )
+		return localPlayerInfo;
+	else
+		return remotePlayerInfo;
+}
+const PlayerInfo &GameRules::GetPlayerInfo( const Player &player ) const
+{
+	if ( player == Player::Local )
+		return localPlayerInfo;
+	else
+		return remotePlayerInfo;
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include <SDL2/SDL.h>
+
+struct Ball;
+struct Tile;
+struct Paddle;
+struct DeadPieces;
+struct PlayerInfo;
+class ConfigLoader;
+class PhysicsManager;
+enum class Player : int;
+enum class TileType : int;
+
+// Told about what GameRules has done, so it can be drawn and sent to the other player
+// Does nothing by default, SimulationMatch doesn't need to know
+class GameRulesListener
+{
+	public:
+		virtual ~GameRulesListener();
+
+		// Off a wall, a paddle or a tile. Only the balls GameRules moves bounce
+		virtual void OnBallBounced( const std::shared_ptr< Ball > &ball );
+		// After the tile has been hit. tilesDestroyed is more than one when it exploded
+		virtual void OnBallHitTile( const std::shared_ptr< Ball > &ball, const std::shared_ptr< Tile > &tile, int32_t tilesDestroyed );
+
+		// Hit by a ball or a bullet, it might still be alive
+		virtual void OnTileHit( const std::shared_ptr< Tile > &tile );
+		// Killed by an explosion, once for every tile in it
+		virtual void OnTileExploded( const std::shared_ptr< Tile > &tile );
+
+		virtual void OnPointsChanged( const Player &player, uint32_t points );
+		// After the owner's active ball count has gone down, and the life has been taken if it was the last one
+		virtual void OnBallLost( const std::shared_ptr< Ball > &ball );
+		virtual void OnLifeLost( const Player &player );
+};
+
+// What happens when the balls hit something, and how the players get points and lose lives
+// GameManager, SimulationMatch and the benchmarks all play by these rules
+// The caller owns the pieces, the players and the config, and decides when balls are served and levels start
+class GameRules
+{
+	public:
+		GameRules( PhysicsManager &physicsManager_, const ConfigLoader &config_, PlayerInfo &localPlayerInfo_, PlayerInfo &remotePlayerInfo_ );
+
+		// nullptr for nobody
+		void SetListener( GameRulesListener* listener_ );
+		void SetWindowSize( const SDL_Rect &windowSize_ );
+		void SetPaddles( const std::shared_ptr< Paddle > &localPaddle_, const std::shared_ptr< Paddle > &remotePaddle_ );
+
+		// In a network game the remote player's balls are moved by the other player, here they're only predicted between ball data messages
+		// SimulationMatch and the benchmarks play for both players, so both players' balls hit things
+		void SetPlaysBothPlayers( bool playsBothPlayers_ );
+		// For the benchmarks, so that every frame plays out on the same board
+		// Tiles aren't hit, normal balls back out of them, and balls that fall out are served again instead of killed
+		void SetIndestructible( bool isIndestructible_ );
+
+		// Moves the balls, and bounces them off the walls, the paddles and the tiles. Balls that fall out are killed
+		void UpdateBalls( const std::vector< std::shared_ptr< Ball > > &ballList, double delta );
+
+		// Hits the tile, or kills it for a super ball or super bullet, and gives owner the points
+		// Returns how many tiles were destroyed, for the bonus box chance. Always 1 unless the tile exploded
+		int32_t HitTile( const std::shared_ptr< Tile > &tile, const Player &owner, bool kill );
+		void IncrementPoints( TileType tileType, bool isDestroyed, const Player &owner );
+
+		// Takes what died this tick from the PhysicsManager. A player that lost its last ball loses a life
+		// Returns false if nothing died
+		bool TakeDeadPieces( DeadPieces &dead );
+
+		bool IsLevelDone() const;
+		bool IsGameOver() const;
+		bool AnyFastModeActive() const;
+
+		PlayerInfo &GetPlayerInfo( const Player &player );
+		const PlayerInfo &GetPlayerInfo( const Player &player ) const;
+
+	private:
+		void UpdatePlayerBalls( const std::vector< std::shared_ptr< Ball > > &ballList, const Player &owner );
+		// isSuperBall can't change until the next frame, so it's picked once for all of the player's balls
+		template < bool isSuperBall >
+		void UpdateBallCollisions( const std::vector< std::shared_ptr< Ball > > &ballList, const Player &owner );
+		template < bool isSuperBall >
+		void CheckBallTileIntersection( const std::shared_ptr< Ball > &ball );
+		void PredictBalls( const std::vector< std::shared_ptr< Ball > > &ballList, const Player &owner, double delta );
+
+		int32_t HandleExplosions( const std::shared_ptr< Tile > &explodingTile, const Player &owner );
+
+		void ReduceActiveBalls( const std::shared_ptr< Ball > &ball );
+		void ReducePlayerLifes( const Player &player );
+
+		PhysicsManager &physicsManager;
+		const ConfigLoader &config;
+
+		PlayerInfo &localPlayerInfo;
+		PlayerInfo &remotePlayerInfo;
+
+		std::shared_ptr< Paddle > localPaddle;
+		std::shared_ptr< Paddle > remotePaddle;
+
+		// Used when nobody listens, so there's always someone to tell
+		GameRulesListener noListener;
+		GameRulesListener* listener;
+
+		SDL_Rect windowSize;
+		bool playsBothPlayers;
+		bool isIndestructible;
+
+		GameRules( const GameRules &other );
+		GameRules& operator=( const GameRules &other );
+};
@@ -16,12 +16,28 @@ class Logger
 	{
 
 	}
+	Logger( bool logCout_, bool logFile_ )
+		:	logCout( logCout_ )
+		,	logFile( logFile_ )
+		,	inited( false )
+	{
+
+	}
+	// The logger used by the calling thread. Everyone shares the same one unless SetCurrent has been called
+	// Objects store the pointer when they're created, so SetCurrent has to be called before creating them
 	static Logger* Instance()
 	{
+		if ( Current() != nullptr )
+			return Current();
+
 		static Logger instance;
 		return &instance;
 
 	}
+	static void SetCurrent( Logger* logger )
+	{
+		Current() = logger;
+	}
 	void Log( const std::string &fileName, int32_t line, const std::string &msg )
 	{
 		if ( !logCout && !logFile )
@@ -57,6 +73,11 @@ class Logger
 	}
 	private:
 
+	static Logger*& Current()
+	{
+		static thread_local Logger* current = nullptr;
+		return current;
+	}
 	void Write( const std::string &line )
 	{
 		if ( inited )
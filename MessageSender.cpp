@@ -12,6 +12,8 @@
 
 #include "Logger.h"
 
+#include <SDL2/SDL.h>
+
 MessageSender::MessageSender( NetManager &netMan )
 :	netManager( netMan )
 {
@@ -26,7 +28,7 @@ void MessageSender::SendBulletKilledMessage( uint32_t bulletID )
 
 	SendMessage( msg, MessageTarget::Oponent );
 }
-void MessageSender::SendBulletFireMessage( const std::shared_ptr< Bullet > &bulletLeft, const std::shared_ptr< Bullet > &bulletRight, double height  )
+void MessageSender::SendBulletFireMessage( const std::shared_ptr< Bullet > &bulletLeft, const std::shared_ptr< Bullet > &bulletRight )
 {
 	TCPMessage msg;
 	std::stringstream ss;
@@ -35,12 +37,12 @@ void MessageSender::SendBulletFireMessage( const std::shared_ptr< Bullet > &bull
 	msg.SetObjectID( bulletLeft->GetObjectID() );
 	msg.SetObjectID2( bulletRight->GetObjectID() );
 
-	msg.SetPos1( FlipPosition( bulletLeft->rect , height ));
-	msg.SetPos2( FlipPosition( bulletRight->rect, height ));
+	msg.SetPos1( LogicalPosition::FromFieldFlipped( bulletLeft->rect ) );
+	msg.SetPos2( LogicalPosition::FromFieldFlipped( bulletRight->rect ) );
 
 	SendMessage( msg, MessageTarget::Oponent );
 }
-void MessageSender::SendBonusBoxSpawnedMessage( const std::shared_ptr< BonusBox > &bonusBox, double height )
+void MessageSender::SendBonusBoxSpawnedMessage( const std::shared_ptr< BonusBox > &bonusBox )
 {
 	TCPMessage msg;
 
@@ -48,7 +50,7 @@ void MessageSender::SendBonusBoxSpawnedMessage( const std::shared_ptr< BonusBox
 	msg.SetObjectID( bonusBox->GetObjectID() );
 	msg.SetBonusType( bonusBox->GetBonusType() );
 
-	msg.SetPos1( FlipPosition( bonusBox->rect , height ));
+	msg.SetPos1( LogicalPosition::FromFieldFlipped( bonusBox->rect ) );
 
 	msg.SetDir( bonusBox->GetDirection_YFlipped() );
 
@@ -72,7 +74,7 @@ void MessageSender::SendBallKilledMessage( uint32_t ballID )
 
 	SendMessage( msg, MessageTarget::Oponent );
 }
-void MessageSender::SendBallSpawnMessage( const std::shared_ptr<Ball> &ball, double height )
+void MessageSender::SendBallSpawnMessage( const std::shared_ptr<Ball> &ball )
 {
 	TCPMessage msg;
 	Rect r = ball->rect;
@@ -80,12 +82,13 @@ void MessageSender::SendBallSpawnMessage( const std::shared_ptr<Ball> &ball, dou
 	msg.SetMessageType( MessageType::BallSpawned );
 	msg.SetObjectID( ball->GetObjectID() );
 
-	msg.SetPos1( FlipPosition( r , height ));
+	msg.SetPos1( LogicalPosition::FromFieldFlipped( r ) );
 	msg.SetDir( ball->GetDirection_YFlipped()  );
+	msg.SetTimeStamp( SDL_GetTicks() );
 
 	SendMessage( msg, MessageTarget::Oponent );
 }
-void MessageSender::SendBallDataMessage( const std::shared_ptr<Ball> &ball, double height )
+void MessageSender::SendBallDataMessage( const std::shared_ptr<Ball> &ball )
 {
 	TCPMessage msg;
 	Rect r = ball->rect;
@@ -94,8 +97,9 @@ void MessageSender::SendBallDataMessage( const std::shared_ptr<Ball> &ball, doub
 	msg.SetObjectID( ball->GetObjectID()  );
 
 	//msg.SetPos1( Vector2f( r.x, windowHeight - r.y  ) );
-	msg.SetPos1( FlipPosition( r , height ));
+	msg.SetPos1( LogicalPosition::FromFieldFlipped( r ) );
 	msg.SetDir( ball->GetDirection_YFlipped() );
+	msg.SetTimeStamp( SDL_GetTicks() );
 
 	SendMessage( msg, MessageTarget::Oponent );
 }
@@ -107,7 +111,7 @@ void MessageSender::SendBallRespawnMessage()
 
 	SendMessage( msg, MessageTarget::Oponent );
 }
-void MessageSender::SendTileSpawnMessage( const std::shared_ptr<Tile> &tile, double height )
+void MessageSender::SendTileSpawnMessage( const std::shared_ptr<Tile> &tile )
 {
 	TCPMessage msg;
 	Rect r = tile->rect;
@@ -116,7 +120,7 @@ void MessageSender::SendTileSpawnMessage( const std::shared_ptr<Tile> &tile, dou
 	msg.SetObjectID( tile->GetObjectID() );
 
 	msg.SetTileType( tile->GetTileType() );
-	msg.SetPos1( FlipPosition( r, height ));
+	msg.SetPos1( LogicalPosition::FromFieldFlipped( r ) );
 
 	SendMessage( msg, MessageTarget::Oponent );
 }
@@ -153,7 +157,7 @@ void MessageSender::SendPaddlePosMessage( double xPos  )
 	TCPMessage msg;
 
 	msg.SetMessageType( MessageType::PaddlePosition );
-	msg.SetPos1( Vector2f( xPos, 0 ) );
+	msg.SetPos1( LogicalPosition::FromField( Vector2f( xPos, 0.0 ) ) );
 
 	std::stringstream ss;
 	ss << msg;
@@ -242,25 +246,68 @@ void MessageSender::SendLevelNameMessage( const std::string levelName )
 
 	SendMessage( msg, MessageTarget::Oponent );
 }
+void MessageSender::SendPingMessage( uint32_t ticks )
+{
+	TCPMessage msg;
+	msg.SetMessageType( MessageType::Ping );
+	msg.SetTimeStamp( ticks );
+
+	SendMessage( msg, MessageTarget::Oponent );
+}
+void MessageSender::SendPongMessage( uint32_t pingTicks, uint32_t ticks )
+{
+	TCPMessage msg;
+	msg.SetMessageType( MessageType::Pong );
+	msg.SetTimeStamp( ticks );
+	msg.SetEchoTimeStamp( pingTicks );
+
+	SendMessage( msg, MessageTarget::Oponent );
+}
+void MessageSender::SendUDPHandshakeMessage( uint16_t udpPort )
+{
+	TCPMessage msg;
+	msg.SetMessageType( MessageType::UDPHandshake );
+	msg.SetPort( udpPort );
+
+	SendMessage( msg, MessageTarget::Oponent, true );
+}
 void MessageSender::SendMessage( const TCPMessage &message, const MessageTarget &target, bool print )
 {
 	std::stringstream ss("");
 	ss << message;
+	const std::string str = ss.str();
 
 	if ( target == MessageTarget::Oponent )
-		netManager.SendMessage( ss.str() );
+	{
+		if ( !SendUnreliableMessage( message, str ) )
+			netManager.SendMessage( str.data(), str.size() );
+	}
 	else
-		netManager.SendMessageToServer( ss.str() );
+		netManager.SendMessageToServer( str.data(), str.size() );
 
 	if ( print )
 		PrintSend( message );
 }
-void MessageSender::PrintSend( const TCPMessage &msg )
+bool MessageSender::SendUnreliableMessage( const TCPMessage &message, const std::string &str )
 {
-	logger->Log( __FILE__, __LINE__, "Message sent ", msg.Print() );
+	// Only messages that are replaced by the next one of the same kind can be lost
+	// Everything else ( tile hits, bonuses, game state, ... ) has to arrive, so it goes over TCP
+	switch ( message.GetType() )
+	{
+		case MessageType::PaddlePosition:
+		case MessageType::BallData:
+			break;
+		default:
+			return false;
+	}
+
+	// Each ball gets its own stream so an update for one ball doesn't make an older update for another ball stale
+	uint32_t streamID = ( static_cast< uint32_t > ( message.GetType() ) << 16 ) | ( message.GetObjectID() & 0xFFFF );
+
+	return netManager.SendUnreliableMessage( str, streamID );
 }
-Vector2f MessageSender::FlipPosition( Rect originalPos, double height )
+void MessageSender::PrintSend( const TCPMessage &msg )
 {
-	return Vector2f( originalPos.x , height - originalPos.y  - originalPos.h );
+	logger->Log( __FILE__, __LINE__, "Message sent ", msg.Print() );
 }
 
@@ -22,12 +22,12 @@ public:
 	MessageSender( NetManager &netMan );
 
 	void SendBulletKilledMessage( uint32_t bulletID );
-	void SendBulletFireMessage( const std::shared_ptr< Bullet > &bulletLeft, const std::shared_ptr< Bullet > &bulletRight, double height  );
-	void SendBonusBoxSpawnedMessage( const std::shared_ptr< BonusBox > &bonusBox, double height );
+	void SendBulletFireMessage( const std::shared_ptr< Bullet > &bulletLeft, const std::shared_ptr< Bullet > &bulletRight );
+	void SendBonusBoxSpawnedMessage( const std::shared_ptr< BonusBox > &bonusBox );
 	void SendBonusBoxPickupMessage( uint32_t boxID );
 	void SendBallKilledMessage( uint32_t ballID );
-	void SendBallSpawnMessage( const std::shared_ptr<Ball> &ball, double height );
-	void SendBallDataMessage( const std::shared_ptr<Ball> &ball, double height );
+	void SendBallSpawnMessage( const std::shared_ptr<Ball> &ball );
+	void SendBallDataMessage( const std::shared_ptr<Ball> &ball );
 	void SendBallRespawnMessage();
 	void SendLevelDoneMessage( );
 	void SendPaddlePosMessage( double xPos  );
@@ -35,7 +35,7 @@ public:
 	void SendGameSettingsMessage( const Vector2f &size, double scale );
 	void SendGameStateChangedMessage( const GameState &gameState );
 
-	void SendTileSpawnMessage( const std::shared_ptr<Tile> &tile, double height );
+	void SendTileSpawnMessage( const std::shared_ptr<Tile> &tile );
 	void SendTileHitMessage( uint32_t tileID, bool tileKilled = false );
 	void SendLastTileMessage( );
 
@@ -46,10 +46,14 @@ public:
 
 	void SendLevelNameMessage( const std::string levelName );
 
+	void SendPingMessage( uint32_t ticks );
+	void SendPongMessage( uint32_t pingTicks, uint32_t ticks );
+	void SendUDPHandshakeMessage( uint16_t udpPort );
+
 private:
 	void SendMessage( const TCPMessage &message, const MessageTarget &target, bool print = false );
+	bool SendUnreliableMessage( const TCPMessage &message, const std::string &str );
 	void PrintSend( const TCPMessage &msg );
-	Vector2f FlipPosition( Rect originalPos, double height );
 
 	NetManager &netManager;
 	Logger *logger;
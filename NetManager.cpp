@@ -1,9 +1,23 @@
 #include "NetManager.h"
 
 #include <algorithm>
+#include <iostream>
+
+#include <SDL2/SDL.h>
 
 #include "structs/net/TCPMessage.h"
+#include "structs/net/TCPMessageParser.h"
 
+NetManager::NetManager()
+	:	portNr( 0 )
+	,	isServer( false )
+	,	isReady( false )
+	,	useUDP( false )
+	,	udpRemotePort( 0 )
+	,	conditions()
+	,	connectedAt( 0 )
+{
+}
 void NetManager::Init( bool server)
 {
 	isServer = server;
@@ -39,6 +53,9 @@ void NetManager::Close()
 {
 	isReady = false;
 	gameServer.Close();
+	udpConnection.Close();
+	udpRemotePort = 0;
+	connectedAt = 0;
 }
 void NetManager::Update()
 {
@@ -51,31 +68,42 @@ void NetManager::Update()
 	}
 	gameServer.Update();
 }
-std::string NetManager::ReadMessage( )
+bool NetManager::ReadMessages( TCPMessageParser &parser )
+{
+	if ( isServer )
+		return gameServer.ReadMessages( parser );
+	else
+		return gameClient.ReadMessages( parser );
+}
+bool NetManager::ReadMessagesFromServer( TCPMessageParser &parser )
+{
+	return mainServer.ReadMessages( parser );
+}
+void NetManager::ConsumeMessages( const TCPMessageParser &parser )
 {
 	if ( isServer )
-		return gameServer.ReadMessages();
+		gameServer.ConsumeMessages( parser );
 	else
-		return gameClient.ReadMessages();
+		gameClient.ConsumeMessages( parser );
 }
-std::string NetManager::ReadMessageFromServer( )
+void NetManager::ConsumeMessagesFromServer( const TCPMessageParser &parser )
 {
-	return mainServer.ReadMessages();
+	mainServer.ConsumeMessages( parser );
 }
-void NetManager::SendMessage( std::string str )
+void NetManager::SendMessage( const char* data, size_t size )
 {
 	if ( isServer )
 	{
-		gameServer.Send( str );
+		gameServer.Send( data, size );
 	}
 	else
 	{
-		gameClient.Send( str );
+		gameClient.Send( data, size );
 	}
 }
-void NetManager::SendMessageToServer( std::string str )
+void NetManager::SendMessageToServer( const char* data, size_t size )
 {
-	mainServer.Send( str );
+	mainServer.Send( data, size );
 }
 bool NetManager::IsServer() const
 {
@@ -110,3 +138,115 @@ bool NetManager::IsConnectedToGameServer() const
 {
 	return mainServer.IsConnected();
 }
+// UDP
+// ===========================================================================
+void NetManager::SetUseUDP( bool useUDP_ )
+{
+	useUDP = useUDP_;
+}
+bool NetManager::IsUDPRequested() const
+{
+	return useUDP;
+}
+bool NetManager::IsUDPActive() const
+{
+	return useUDP && udpConnection.IsOpen() && udpConnection.HasRemote();
+}
+uint16_t NetManager::OpenUDP()
+{
+	if ( !useUDP )
+		return 0;
+
+	// Both players can be on the same machine, so the server and the client use different ports
+	uint16_t udpPort = static_cast< uint16_t > ( isServer ? portNr + 1 : portNr + 2 );
+
+	if ( !udpConnection.Open( udpPort ) )
+		return 0;
+
+	// The oponent might have sent its port before we opened our socket
+	SetUDPRemote();
+
+	return udpPort;
+}
+void NetManager::ConnectUDP( uint16_t remotePort )
+{
+	if ( !useUDP || remotePort == 0 )
+		return;
+
+	udpRemotePort = remotePort;
+	SetUDPRemote();
+}
+void NetManager::SetUDPRemote()
+{
+	if ( !udpConnection.IsOpen() || udpRemotePort == 0 )
+		return;
+
+	if ( isServer )
+		udpConnection.SetRemote( gameServer.GetRemoteHost(), udpRemotePort );
+	else
+		udpConnection.SetRemote( gameClient.GetRemoteHost(), udpRemotePort );
+}
+bool NetManager::SendUnreliableMessage( const std::string &str, uint32_t streamID )
+{
+	if ( !IsUDPActive() )
+		return false;
+
+	udpConnection.Send( str, streamID );
+	return true;
+}
+bool NetManager::ReadUnreliableMessages( TCPMessageParser &parser )
+{
+	if ( !useUDP )
+		return false;
+
+	return udpConnection.ReadMessages( parser );
+}
+// Network simulation
+// ===========================================================================
+void NetManager::SetNetworkConditions( const NetworkConditions &conditions_ )
+{
+	conditions = conditions_;
+
+	// The connection to the main server is left alone, only the game connection is affected
+	gameServer.SetNetworkConditions( conditions );
+	gameClient.SetNetworkConditions( conditions );
+	udpConnection.SetNetworkConditions( conditions );
+}
+void NetManager::Flush()
+{
+	if ( isServer )
+		gameServer.Flush();
+	else
+		gameClient.Flush();
+
+	mainServer.Flush();
+	udpConnection.Flush();
+
+	CheckSimulatedDisconnect();
+}
+void NetManager::CheckSimulatedDisconnect()
+{
+	if ( conditions.disconnectAfter <= 0.0 || !IsConnected() )
+		return;
+
+	uint32_t now = SDL_GetTicks();
+
+	if ( connectedAt == 0 )
+	{
+		connectedAt = now;
+		return;
+	}
+
+	if ( ( now - connectedAt ) < static_cast< uint32_t > ( conditions.disconnectAfter * 1000.0 ) )
+		return;
+
+	std::cout << "NetManager.cpp@" << __LINE__ << " Simulating disconnect after " << conditions.disconnectAfter << " seconds" << std::endl;
+
+	if ( isServer )
+		gameServer.Close();
+	else
+		gameClient.Close();
+
+	udpConnection.Close();
+	connectedAt = 0;
+}
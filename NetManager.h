@@ -1,20 +1,28 @@
 #pragma once
 
 #include "structs/net/TCPConnection.h"
+#include "structs/net/UDPConnection.h"
 
+class TCPMessageParser;
 class NetManager
 {
 	public:
+		NetManager();
+
 		void Init( bool server );
 		void Connect( std::string IP, unsigned short port );
 		void Close();
 		void Update();
 
-		std::string ReadMessage( );
-		std::string ReadMessageFromServer( );
+		bool ReadMessages( TCPMessageParser &parser );
+		bool ReadMessagesFromServer( TCPMessageParser &parser );
+
+		void ConsumeMessages( const TCPMessageParser &parser );
+		void ConsumeMessagesFromServer( const TCPMessageParser &parser );
 
-		void SendMessage( std::string str );
-		void SendMessageToServer( std::string str );
+		// Queued, and sent by Flush()
+		void SendMessage( const char* data, size_t size );
+		void SendMessageToServer( const char* data, size_t size );
 
 		bool IsServer() const;
 		bool IsConnected() const;
@@ -25,7 +33,31 @@ class NetManager
 		uint16_t GetPort();
 
 		void SetIsServer( bool isServer_ );
+
+		// Network simulation
+		// ===========================================
+		void SetNetworkConditions( const NetworkConditions &conditions_ );
+		// Sends the queued messages, and anything the network simulator has held back long enough. Called once per frame
+		void Flush();
+
+		// UDP
+		// ===========================================
+		void SetUseUDP( bool useUDP_ );
+		bool IsUDPRequested() const;
+		bool IsUDPActive() const;
+
+		// Opens the local UDP socket and returns its port, or 0 if UDP isn't used
+		uint16_t OpenUDP();
+		// Called when the oponent has told us its UDP port
+		void ConnectUDP( uint16_t remotePort );
+
+		// Returns false if the message has to be sent over TCP instead
+		bool SendUnreliableMessage( const std::string &str, uint32_t streamID );
+		bool ReadUnreliableMessages( TCPMessageParser &parser );
 	private:
+		void SetUDPRemote();
+		void CheckSimulatedDisconnect();
+
 		std::string ipAdress;
 		uint16_t portNr;
 
@@ -34,4 +66,11 @@ class NetManager
 		TCPConnection mainServer;
 		TCPConnection gameServer;
 		TCPConnection gameClient;
+
+		bool useUDP;
+		uint16_t udpRemotePort;
+		UDPConnection udpConnection;
+
+		NetworkConditions conditions;
+		uint32_t connectedAt;
 };
@@ -2,9 +2,11 @@
 
 #include <algorithm>
 #include <csignal>
+#include <limits>
+#include <cmath>
 
 #include "math/RectHelpers.h"
-#include "math/Math.h"
+#include "math/RandomService.h"
 
 #include "structs/game_objects/Ball.h"
 #include "structs/game_objects/Tile.h"
@@ -18,17 +20,25 @@
 PhysicsManager::PhysicsManager( MessageSender &msgSender )
 	:	messageSender( msgSender )
 	,	scale( 1.0 )
+	,	aiPaddleSpeed( 1500.0 )
 	,	objectCount ( 0 )
+	,	collisionTests( 0 )
 {
 	logger = Logger::Instance();
 }
 void PhysicsManager::AddTile( const std::shared_ptr< Tile > &tile )
 {
+	tile->SetGraveyard( &graveyard, PieceType::Tile );
+
 	tileList.push_back( tile );
+	tileColumns.Add( tile );
+	tileTracker.Add( tile );
 }
 void PhysicsManager::RemoveTile( const std::shared_ptr< Tile >  &tile )
 {
 	tileList.erase( std::find( tileList.begin(), tileList.end(), tile) );
+	tileColumns.Remove( tile );
+	tileTracker.Remove( tile );
 }
 std::shared_ptr< Tile > PhysicsManager::GetTileWithID( int32_t ID)
 {
@@ -71,6 +81,8 @@ std::shared_ptr< Tile > PhysicsManager::FindClosestIntersectingTile( const std::
 		if ( !p->IsAlive() )
 			continue;
 
+		++collisionTests;
+
 		if ( !ball->CheckTileSphereIntersection( p->rect, ball->rect, current ) )
 		{
 			current = std::numeric_limits< double >::max();
@@ -86,18 +98,21 @@ std::shared_ptr< Tile > PhysicsManager::FindClosestIntersectingTile( const std::
 
 	return closestTile;
 }
-int32_t PhysicsManager::CountDestroyableTiles()
+int32_t PhysicsManager::CountDestroyableTiles() const
 {
-	auto IsTileDestroyable = []( const std::shared_ptr< Tile > &tile )
-	{
-		return ( tile->GetTileType() != TileType::Unbreakable );
-	};
-
-	return static_cast< int32_t > ( std::count_if( tileList.begin(), tileList.end(), IsTileDestroyable ) );
+	return tileTracker.CountDestroyable();
+}
+int32_t PhysicsManager::CountAllTiles() const
+{
+	return tileTracker.CountAlive();
+}
+uint64_t PhysicsManager::GetCollisionTestCount() const
+{
+	return collisionTests;
 }
-int32_t PhysicsManager::CountAllTiles()
+void PhysicsManager::ResetCollisionTestCount()
 {
-	return static_cast< int32_t> ( tileList.size() );
+	collisionTests = 0;
 }
 void PhysicsManager::PrintTileList() const
 {
@@ -115,6 +130,7 @@ void PhysicsManager::PrintTileList() const
 // =============================================================================================================
 void PhysicsManager::AddBall( const std::shared_ptr< Ball > &ball )
 {
+	ball->SetGraveyard( &graveyard, PieceType::Ball );
 	ballList.push_back( ball );
 }
 void PhysicsManager::RemoveBall( const std::shared_ptr< Ball >  &ball )
@@ -129,10 +145,9 @@ std::shared_ptr< Ball >  PhysicsManager::CreateBall( const Player &owner, uint32
 	std::shared_ptr< Ball > ball = std::make_shared< Ball >( windowSize, owner, ballID );
 	ball->textureType = TextureType::e_Ball;
 
-	double scale_ = ( windowSize.h ) / 1080.0;
-	ball->SetSpeed( speed * scale_ );
+	ball->SetSpeed( speed );
 
-	ballList.push_back( ball );
+	AddBall( ball );
 
 	return ball;
 }
@@ -144,18 +159,25 @@ void PhysicsManager::RemoveBallWithID( int32_t ID, const Player &owner )
 		ball->Kill();
 }
 std::shared_ptr< Ball > PhysicsManager::GetBallWithID( int32_t ID, const Player &owner )
+{
+	const auto &ball = FindBallWithID( ID, owner );
+
+	if ( ball != nullptr )
+		return ball;
+
+	logger->Log( __FILE__, __LINE__, "Ball doesn't exist : ", ID );
+	raise ( SIGABRT );
+
+	return nullptr;
+}
+std::shared_ptr< Ball > PhysicsManager::FindBallWithID( int32_t ID, const Player &owner ) const
 {
 	for ( const auto &p : ballList )
 	{
 		if ( ID == p->GetObjectID() && p->GetOwner() == owner  )
-		{
 			return p;
-		}
 	}
 
-	logger->Log( __FILE__, __LINE__, "Ball doesn't exist : ", ID );
-	raise ( SIGABRT );
-
 	return nullptr;
 }
 bool PhysicsManager::KillAllBallsWithOwner( const Player &player )
@@ -182,27 +204,12 @@ void PhysicsManager::UpdateBallSpeed( double localPlayerSpeed, double remotePlay
 	};
 	std::for_each( ballList.begin(), ballList.end(), setBallSpeed );
 }
-std::shared_ptr< Ball > PhysicsManager::FindHighestBall()
-{
-	double yMax = 0;
-	std::shared_ptr< Ball > highest = nullptr;;
-	for ( const auto &p : ballList )
-	{
-		if ( p->GetOwner() == Player::Local )
-		{
-			if ( p->rect.y > yMax )
-			{
-				highest = p;
-				yMax = p->rect.y;
-			}
-		}
-	}
-	return highest;
-}
 // Bonus Boxes
 // =============================================================================================================
 void PhysicsManager::AddBonusBox( const std::shared_ptr< BonusBox > &bb )
 {
+	bb->SetGraveyard( &graveyard, PieceType::BonusBox );
+
 	bonusBoxList.push_back( bb );
 }
 void PhysicsManager::RemoveBonusBox( const std::shared_ptr< BonusBox >  &bb )
@@ -224,7 +231,7 @@ std::shared_ptr< BonusBox > PhysicsManager::CreateBonusBox( uint32_t ID, const P
 	bonusBox->SetSpeed( bonusBoxSpeed );
 	SetBonusBoxDirection( bonusBox, dir );
 
-	bonusBoxList.push_back( bonusBox );
+	AddBonusBox( bonusBox );
 	return bonusBox;
 }
 std::shared_ptr< BonusBox > PhysicsManager::GetBonusBoxWithID( int32_t ID, const Player &owner )
@@ -271,7 +278,7 @@ void PhysicsManager::SetBonusBoxDirection( const std::shared_ptr< BonusBox > &bo
 }
 BonusType PhysicsManager::GetRandomBonusType() const
 {
-	int rand = RandomHelper::GenRandomNumber( 1000 );
+	int rand = RandomService::Get( RandomStream::Gameplay ).GenRandomNumber( 1000 );
 
 	if ( rand < 400 )
 		return BonusType::BallSplit;
@@ -290,6 +297,8 @@ BonusType PhysicsManager::GetRandomBonusType() const
 // =============================================================================================================
 void PhysicsManager::AddBullet( const std::shared_ptr< Bullet > &bullet )
 {
+	bullet->SetGraveyard( &graveyard, PieceType::Bullet );
+
 	bulletList.push_back( bullet );
 }
 void PhysicsManager::RemoveBullet( const std::shared_ptr< Bullet >  &bullet )
@@ -321,7 +330,7 @@ std::shared_ptr< Bullet >  PhysicsManager::CreateBullet( int32_t id, const Playe
 	bullet->SetPosition( pos );
 	bullet->SetOwner( owner );
 
-	bulletList.push_back( bullet );
+	AddBullet( bullet );
 
 	return bullet;
 }
@@ -344,23 +353,25 @@ bool PhysicsManager::DidBulletHitTile( const std::shared_ptr< Bullet > &bullet,
 }
 std::shared_ptr< Tile > PhysicsManager::CheckBulletTileIntersections( const std::shared_ptr< Bullet > &bullet )
 {
-	bool bulletHitTile = false;
 	std::shared_ptr< Tile > lowestTile;
 	double lowestTileY = 0;
 
-	for ( const auto &tile : tileList )
+	// Only the tiles in the bullet's column that reach below its top
+	auto checkTile = [ this, &bullet, &lowestTile, &lowestTileY ]( const std::shared_ptr< Tile > &tile )
 	{
-		if ( !DidBulletHitTile( bullet, tile ) )
-			continue;
+		++collisionTests;
 
-		bulletHitTile = true;
+		if ( !DidBulletHitTile( bullet, tile ) )
+			return;
 
 		if ( tile->rect.y > lowestTileY )
 		{
 			lowestTile = tile;
 			lowestTileY = tile->rect.y;
 		}
-	}
+	};
+
+	tileColumns.ForEachBelow( bullet->rect.x, bullet->rect.x + bullet->rect.w, bullet->rect.y, checkTile );
 
 	return lowestTile;
 }
@@ -368,11 +379,15 @@ std::vector< std::shared_ptr< Tile > >  PhysicsManager::FindAllTilesOnBulletsPat
 {
 	std::vector< std::shared_ptr< Tile > > tilesHitByBullet;
 
-	for ( const auto &tile : tileList )
+	auto checkTile = [ &bullet, &tilesHitByBullet ]( const std::shared_ptr< Tile > &tile )
 	{
 		if ( bullet->WillHitTile( tile->rect ) )
 			tilesHitByBullet.push_back( tile );
-	}
+	};
+
+	// Everything in the column, however far up
+	double top = std::numeric_limits< double >::lowest();
+	tileColumns.ForEachBelow( bullet->rect.x, bullet->rect.x + bullet->rect.w, top, checkTile );
 
 	return tilesHitByBullet;
 }
@@ -382,7 +397,7 @@ void PhysicsManager::RespawnBalls( const Player &owner, double ballSpeed )
 	{
 		if ( ball->GetOwner() == owner )
 
-			ball->SetSpeed ( ballSpeed * ( ( windowSize.h ) / 1080.0 ));
+			ball->SetSpeed ( ballSpeed );
 			auto dir = ball->GetDirection();
 
 			if ( (owner == Player::Local && dir.y > 0.0 ) || (owner == Player::Remote && dir.y < 0.0 ) )
@@ -410,9 +425,9 @@ void PhysicsManager::SetPaddleData( )
 	remotePaddle->rect.y = remotePaddle->rect.h * 0.5;
 	remotePaddle->SetScale( scale );
 }
-void PhysicsManager::SetLocalPaddlePosition( int32_t x )
+void PhysicsManager::SetLocalPaddlePosition( double x )
 {
-	localPaddle->rect.x = static_cast< double > ( x ) - ( localPaddle->rect.w / 2 );
+	localPaddle->rect.x = x - ( localPaddle->rect.w / 2 );
 
 	if ( ( localPaddle->rect.x + localPaddle->rect.w ) > windowSize.w )
 		localPaddle->rect.x = static_cast< double > ( windowSize.w ) - localPaddle->rect.w;
@@ -422,41 +437,162 @@ void PhysicsManager::SetLocalPaddlePosition( int32_t x )
 
 	messageSender.SendPaddlePosMessage( localPaddle->rect.x );
 }
-bool PhysicsManager::IsTimeForAIMove( std::shared_ptr< Ball > highest ) const
+void PhysicsManager::SetAIPaddleSpeed( double aiPaddleSpeed_ )
+{
+	aiPaddleSpeed = aiPaddleSpeed_;
+}
+void PhysicsManager::AIMove( const Player &player, double delta )
 {
-	if ( !localPaddle )
+	const auto &paddle = ( player == Player::Local ) ? localPaddle : remotePaddle;
+
+	if ( !paddle )
 	{
-		logger->Log( __FILE__, __LINE__, "Local paddle invalid!" );
+		logger->Log( __FILE__, __LINE__, "Paddle invalid!" );
 		raise( SIGABRT );
-		return false;
+		return;
 	}
 
-	if ( ballList.size() == 0 )
-		return false;
+	double paddleSpeed = aiPaddleSpeed;
+	double paddleCenter = paddle->rect.x + ( paddle->rect.w / 2.0 );
+	double reach = paddleSpeed * delta;
+
+	std::shared_ptr< Ball > target = nullptr;
+	double targetX = 0.0;
+	double targetTime = std::numeric_limits< double >::max();
+	bool targetReachable = false;
+
+	// The most urgent ball the paddle can still get to wins. If it can't make it to any of them, it goes for the most urgent one
+	for ( const auto &p : ballList )
+	{
+		if ( p->GetOwner() != player )
+			continue;
+
+		double landingX = 0.0;
+		double time = 0.0;
+
+		if ( !PredictBallLanding( p, *paddle, landingX, time ) )
+			continue;
 
-	if ( highest == nullptr )
+		double distance = std::fabs( landingX - paddleCenter ) - ( paddle->rect.w / 2.0 );
+		bool reachable = ( distance <= paddleSpeed * time );
+
+		if ( ( reachable && !targetReachable ) || ( reachable == targetReachable && time < targetTime ) )
+		{
+			target = p;
+			targetX = landingX;
+			targetTime = time;
+			targetReachable = reachable;
+		}
+	}
+
+	if ( !target )
+		return;
+
+	AIState &state = aiStates[ static_cast< size_t > ( player ) ];
+
+	// Hitting the ball off center gives a different angle every time, otherwise the ball can end up going back and forth along the same path
+	// Only picked for a new target or when the time left goes up ( the ball bounced off something ), so the paddle doesn't shake
+	if ( target->GetObjectID() != state.targetID || targetTime > state.targetTime )
+	{
+		state.targetID = target->GetObjectID();
+		state.aimOffset = ( paddle->rect.w / 2.0 ) * 0.8 * RandomService::Get( RandomStream::AI ).GenRandomNumber( -1.0, 1.0 );
+	}
+
+	state.targetTime = targetTime;
+
+	double move = ( targetX + state.aimOffset ) - paddleCenter;
+	move = std::max( -reach, std::min( reach, move ) );
+
+	paddle->rect.x += move;
+
+	if ( ( paddle->rect.x + paddle->rect.w ) > windowSize.w )
+		paddle->rect.x = static_cast< double > ( windowSize.w ) - paddle->rect.w;
+
+	if ( paddle->rect.x < 0.0 )
+		paddle->rect.x = 0.0;
+}
+bool PhysicsManager::PredictBallLanding( const std::shared_ptr< Ball > &ball, const Paddle &paddle, double &landingX, double &time ) const
+{
+	Vector2f dir = ball->GetDirection();
+	double speedX = ball->GetSpeed() * dir.x;
+
+	// Everything along y is measured from the paddle towards the opposite wall, so both paddles use the same math
+	// distance is how far the ball has to go to reach the paddle, span is the distance between the paddle and the opposite wall
+	double approachSpeed = 0.0;
+	double distance = 0.0;
+	double span = 0.0;
+
+	if ( ball->GetOwner() == Player::Local )
+	{
+		approachSpeed = ball->GetSpeed() * dir.y;
+		distance = paddle.rect.y - ( ball->rect.y + ball->rect.h );
+		span = paddle.rect.y - ball->rect.h - windowSize.y;
+	}
+	else
+	{
+		approachSpeed = ball->GetSpeed() * -dir.y;
+		distance = ball->rect.y - ( paddle.rect.y + paddle.rect.h );
+		span = ( windowSize.y + windowSize.h ) - ball->rect.h - ( paddle.rect.y + paddle.rect.h );
+	}
+
+	if ( std::fabs( approachSpeed ) < 0.0001 )
 		return false;
 
-	if ( highest->GetOwner() == Player::Remote )
+	// Already past the paddle
+	if ( distance < 0.0 && approachSpeed > 0.0 )
 		return false;
 
-	if ( ( highest->rect.y + highest->rect.h ) <  localPaddle->rect.y  )
+	// A ball going away from the paddle is assumed to bounce off the opposite wall without hitting any tiles
+	if ( approachSpeed > 0.0 )
+		time = distance / approachSpeed;
+	else
+		time = ( ( span - distance ) + span ) / -approachSpeed;
+
+	// The side walls are mirrors, so the path is a straight line folded back into [ left, right - ball width ]
+	double left = static_cast< double > ( windowSize.x );
+	double width = static_cast< double > ( windowSize.w ) - ball->rect.w;
+
+	if ( width <= 0.0 )
 		return false;
 
+	double x = std::fmod( ( ball->rect.x - left ) + speedX * time, 2.0 * width );
+
+	if ( x < 0.0 )
+		x += 2.0 * width;
+
+	if ( x > width )
+		x = 2.0 * width - x;
+
+	landingX = left + x + ( ball->rect.w / 2.0 );
 	return true;
 }
-void PhysicsManager::AIMove()
+// Dead pieces
+// =============================================================================================================
+bool PhysicsManager::TakeDeadPieces( DeadPieces &dead )
+{
+	return graveyard.Take( dead );
+}
+void PhysicsManager::RemoveDeadPieces( const DeadPieces &dead )
 {
-	const auto &highest = FindHighestBall();
+	if ( !dead.balls.empty() )
+		Graveyard::Compact( ballList );
 
-	if ( !IsTimeForAIMove( highest ) )
-		return;
+	if ( !dead.tiles.empty() )
+	{
+		Graveyard::Compact( tileList );
 
-	double deadCenter = ( highest->rect.x + highest->rect.w / 2 ) -
-		( ( localPaddle->rect.w / 2.0) *
-		  RandomHelper::GenRandomNumber( -1.0, 1.0 ) );
+		for ( const auto &tile : dead.tiles )
+		{
+			tileColumns.Remove( tile );
+			tileTracker.Remove( tile );
+		}
+	}
+
+	if ( !dead.bullets.empty() )
+		Graveyard::Compact( bulletList );
 
-	localPaddle->rect.x = deadCenter;
+	if ( !dead.bonusBoxes.empty() )
+		Graveyard::Compact( bonusBoxList );
 }
 // Explosions
 // =============================================================================================================
@@ -517,27 +653,31 @@ std::vector< std::shared_ptr< Tile > > PhysicsManager::FindAllExplosiveTilesExce
 
 	return explodingTileVec;
 }
-
-
-double PhysicsManager::ResetScale( )
+std::vector< std::shared_ptr< Tile > > PhysicsManager::FindExplodedTiles( const std::shared_ptr< Tile > &explodingTile ) const
 {
-	double tempScale = 1.0 / scale;
-	scale = 1.0;
+	// Dead tiles stay in the list until the end of the tick, they have already been counted
+	// Picked before the explosion, since that kills the explosive tiles it reaches
+	std::vector< std::shared_ptr< Tile > > exploded;
+	std::copy_if(
+			tileList.begin(),
+			tileList.end(),
+			std::back_inserter( exploded ),
+			[ &explodingTile ]( const std::shared_ptr< Tile > &tile ){ return tile == explodingTile || tile->IsAlive(); }
+			);
 
-	for ( const auto &p : tileList )
-	{
-		p->rect.x = ( p->rect.x * tempScale ) + ( ( windowSize.w - ( windowSize.w * tempScale ) ) * 0.5 );
-		p->rect.y = ( p->rect.y * tempScale ) + ( ( windowSize.h - ( windowSize.h * tempScale ) ) * 0.5 );
+	std::vector< Rect > rectVec = GenereateExplosionRects( explodingTile );
 
-		p->SetScale( tempScale );
-	}
+	auto newEnd = std::remove_if(
+			exploded.begin(),
+			exploded.end(),
+			[ &rectVec ]( const std::shared_ptr< Tile > &tile ){ return !RectHelpers::CheckTileIntersection( rectVec, tile->rect ); }
+			);
+	exploded.erase( newEnd, exploded.end() );
 
-	for ( const auto &p : ballList )
-	{
-		p->SetScale( tempScale );
-	}
-	return scale;
+	return exploded;
 }
+
+
 void PhysicsManager::ApplyScale( double scale_ )
 {
 	scale = scale_;
@@ -550,6 +690,8 @@ void PhysicsManager::ApplyScale( double scale_ )
 		p->ResetScale();
 		p->SetScale( scale );
 	}
+
+	tileColumns.Rebuild( tileList, 60.0 * scale );
 }
 void PhysicsManager::KillBallsAndBonusBoxes( const Player &player )
 {
@@ -591,6 +733,11 @@ void PhysicsManager::SetPaddles( const std::shared_ptr < Paddle > &localPaddle_,
 }
 void PhysicsManager::Clear()
 {
+	tileColumns.Clear();
+
+	for ( const auto &tile : tileList )
+		tileTracker.Remove( tile );
+
 	bulletList.erase( bulletList.begin(), bulletList.end() );
 	tileList.erase( tileList.begin(), tileList.end() );
 }
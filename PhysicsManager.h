@@ -7,6 +7,10 @@
 #include "math/Rect.h"
 #include "enums/TileType.h"
 
+#include "structs/game_objects/TileColumns.h"
+#include "structs/game_objects/TileTracker.h"
+#include "structs/game_objects/Graveyard.h"
+
 #include <SDL2/SDL.h>
 
 struct GamePiece;
@@ -38,10 +42,16 @@ public:
 	std::shared_ptr< Tile > FindClosestIntersectingTile( const std::shared_ptr< Ball > &ball );
 	//bool KillAllTilesWithOwner( const Player &player );
 
-	int32_t CountDestroyableTiles();
-	int32_t CountAllTiles();
+	// Tiles that are still alive
+	int32_t CountDestroyableTiles() const;
+	int32_t CountAllTiles() const;
+
 	void PrintTileList() const;
 
+	// How many times a ball or a bullet has been tested against a tile since the last reset, see BallStorm
+	uint64_t GetCollisionTestCount() const;
+	void ResetCollisionTestCount();
+
 	// Balls
 	// =============================================================================================================
 	void AddBall( const std::shared_ptr< Ball > &ball );
@@ -51,7 +61,8 @@ public:
 	bool KillAllBallsWithOwner( const Player &player );
 
 	std::shared_ptr< Ball > GetBallWithID( int32_t ID, const Player &owner );
-	std::shared_ptr< Ball > FindHighestBall();
+	// Same as GetBallWithID, but returns nullptr if the ball doesn't exist ( anymore )
+	std::shared_ptr< Ball > FindBallWithID( int32_t ID, const Player &owner ) const;
 
 	void UpdateBallSpeed( double localPlayerSpeed, double remotePlayerSpeed );
 
@@ -87,22 +98,32 @@ public:
 	// Paddles
 	// =============================================================================================================
 	void SetPaddleData( );
-	void SetLocalPaddlePosition( int32_t x );
-	bool IsTimeForAIMove( std::shared_ptr< Ball > highest ) const;
-	void AIMove();
+	void SetLocalPaddlePosition( double x );
+	void SetAIPaddleSpeed( double aiPaddleSpeed_ );
+	// Moves the player's paddle towards where the most urgent of its balls will land, no faster than the AI paddle speed
+	void AIMove( const Player &player, double delta );
+
+	// Dead pieces
+	// =============================================================================================================
+	// Everything that was killed since the last call, in the order it died. Returns false if nothing was
+	bool TakeDeadPieces( DeadPieces &dead );
+	// One pass over each list that has lost something
+	void RemoveDeadPieces( const DeadPieces &dead );
 
 	// Explosions
 	// =============================================================================================================
 	std::vector< Rect > GenereateExplosionRects( const std::shared_ptr< Tile > &explodingTile ) const;
 	std::vector< std::shared_ptr< Tile > > FindAllExplosiveTilesExcept( const std::shared_ptr< Tile > &explodingTile ) const;
+	// The live tiles caught in the explosion, explodingTile and the explosive tiles it sets off too
+	std::vector< std::shared_ptr< Tile > > FindExplodedTiles( const std::shared_ptr< Tile > &explodingTile ) const;
 
-	double ResetScale( );
 	void ApplyScale( double scale_ );
 	void KillBallsAndBonusBoxes( const Player &player );
 
 	void SetScale( double scale_ );
 	void SetBulletSpeed( double bulletSpeed_ );
 	void SetBonusBoxSpeed( double bonusBoxSpeed_ );
+	// The field everything is played on ( see ViewTransform ), the same size on every screen
 	void SetWindowSize( const SDL_Rect &wSize );
 	void SetPaddles( const std::shared_ptr < Paddle > &localPaddle_, const std::shared_ptr < Paddle > &remotePaddle_ );
 
@@ -111,11 +132,31 @@ public:
 	void UpdateScale();
 	double GetScale() const;
 private:
+	// Where ( center x ) and when a ball reaches its owner's paddle, assuming it doesn't hit any tiles
+	bool PredictBallLanding( const std::shared_ptr< Ball > &ball, const Paddle &paddle, double &landingX, double &time ) const;
+
+	struct AIState
+	{
+		AIState()
+			:	targetID( -1 )
+			,	targetTime( 0.0 )
+			,	aimOffset( 0.0 )
+		{
+		}
+		int32_t targetID;
+		double targetTime;
+		double aimOffset;
+	};
+
 	std::vector< std::shared_ptr< Ball >  > ballList;
 	std::vector< std::shared_ptr< Tile >  > tileList;
 	std::vector< std::shared_ptr< BonusBox > > bonusBoxList;
 	std::vector< std::shared_ptr< Bullet > > bulletList;
 
+	TileColumns tileColumns;
+	TileTracker tileTracker;
+	Graveyard graveyard;
+
 	std::shared_ptr < Paddle > localPaddle;
 	std::shared_ptr < Paddle > remotePaddle;
 
@@ -128,5 +169,9 @@ private:
 	double bulletSpeed;
 	double bonusBoxSpeed;
 
+	double aiPaddleSpeed;
+	AIState aiStates[2];	// One for each Player
+
 	uint32_t objectCount;
+	uint64_t collisionTests;
 };
@@ -5,6 +5,7 @@
 #include "structs/game_objects/Bullet.h"
 #include "structs/game_objects/Paddle.h"
 #include "structs/game_objects/BonusBox.h"
+#include "structs/game_objects/Graveyard.h"
 
 #include "structs/menu_items/MenuList.h"
 
@@ -17,10 +18,11 @@
 #include "structs/menu_items/PauseMenuItem.h"
 
 #include "math/RectHelpers.h"
+#include "math/RandomService.h"
 
 #include "tools/RenderTools.h"
+#include "tools/RenderThread.h"
 
-#include <sstream>
 #include <iostream>
 #include <algorithm>
 
@@ -67,15 +69,22 @@
 	,	tileTextures{ nullptr, nullptr, nullptr, nullptr }
 	,	hardTileTextures{ nullptr, nullptr, nullptr, nullptr, nullptr }
 #endif
+	,	tileLayer()
+	,	frame()
 	,	tinyFont()
 	,	font()
 	,	mediumFont()
 	,	bigFont()
+	,	hudAtlas()
+	,	optionsAtlas()
 
 	,	margin( 30 )
-	,	scale( 1.0 )
+	,	viewTransform()
 
 	,	lobbyMenuListRect( { 0, 0, 0, 0 })
+
+	,	bonusBoxAtlas()
+	,	particleRandom()
 {
 	particles.resize( 10000 );
 }
@@ -94,7 +103,7 @@ bool Renderer::Init( const SDL_Rect &rect, bool startFS, bool server )
 
 	isFullscreen= startFS;
 	background = rect;
-	scale = ( background.h ) / 1080.0;
+	viewTransform.SetScreenSize( background.w, background.h );
 
 	if ( isFullscreen )
 		screenFlags = SDL_WINDOW_FULLSCREEN;
@@ -138,7 +147,7 @@ bool Renderer::InitSDLSubSystems() const
 }
 bool Renderer::CreateRenderer()
 {
-	renderer = SDL_CreateRenderer( window, -1, SDL_RENDERER_ACCELERATED );//SDL_RENDERER_PREVENTVSYNC
+	renderer = SDL_CreateRenderer( window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE );//SDL_RENDERER_PREVENTVSYNC
 
 	if ( renderer == nullptr )
 	{
@@ -200,7 +209,10 @@ bool Renderer::SetFullscreen( bool fullscreenOn )
 {
 	isFullscreen = fullscreenOn;
 
-	if ( SDL_SetWindowFullscreen( window, (isFullscreen ) ? SDL_WINDOW_FULLSCREEN : 0 ) )
+	int result = 0;
+	RenderThread::Invoke( [ this, &result ](){ result = SDL_SetWindowFullscreen( window, ( isFullscreen ) ? SDL_WINDOW_FULLSCREEN : 0 ); } );
+
+	if ( result != 0 )
 	{
 		std::cout << "Renderer@" << __LINE__  << " Failed to set isFullscreen mode to " << std::boolalpha << isFullscreen << std::endl;
 		std::cout << "Renderer@" << __LINE__  << " Error : " << SDL_GetError() << std::endl;
@@ -231,13 +243,129 @@ bool Renderer::InitializeTextures()
 	InitializeMainMenuTextures();
 	InitGreyAreaRect();
 
+	CreateTileTextures();
+	CreateBonusBoxAtlas();
+
+	// Not fatal, without it the tiles are just drawn one by one every frame
+	tileLayer.Create( renderer, background.w, background.h );
+
+	return true;
+}
+void Renderer::CreateTileTextures()
+{
+	for ( auto &texture : tileTextures )
+		RenderHelpers::DestroyTexture( texture );
+
+	for ( auto &texture : hardTileTextures )
+		RenderHelpers::DestroyTexture( texture );
+
 	for ( uint64_t i = 0; i < tileTextures.size() ; ++i )
 		RenderHelpers::SetTileColorSurface( renderer, i, GetTileColor( i ), tileTextures );
 
 	for ( uint64_t i = 0; i < hardTileTextures.size() ; ++i )
 		RenderHelpers::SetTileColorSurface( renderer, i,  GetHardTileColor( i ) , hardTileTextures );
 
-	return true;
+	// Tiles that are already on the board still point to the old textures
+	for ( const auto &tile : tileList )
+		tile->SetTexture( GetTileTexture( tile ) );
+
+	tileLayer.MarkAllDirty();
+}
+SDL_Texture* Renderer::GetTileTexture( const std::shared_ptr< Tile > &tile ) const
+{
+	if ( tile->GetTileType() == TileType::Hard )
+		return hardTileTextures[ 5 - tile->GetHitsLeft()];
+	else
+		return tileTextures[ tile->GetTileTypeAsIndex() ];
+}
+void Renderer::CreatePlayerTextures( const Player &player )
+{
+	bool isLocal = ( player == Player::Local );
+
+	const SDL_Color &color = isLocal ? colorConfig.localPlayerColor : colorConfig.remotePlayerColor;
+	SDL_Texture* &ballTexture = isLocal ? localPlayerBallTexture : remotePlayerBallTexture;
+	SDL_Texture* &paddleTexture = isLocal ? localPlayerPaddle : remotePlayerPaddle;
+	const std::shared_ptr< Paddle > &paddle = isLocal ? localPaddle : remotePaddle;
+
+	RenderHelpers::DestroyTexture( ballTexture );
+	ballTexture = RenderHelpers::InitSurface( 20, 20, color, renderer );
+
+	for ( const auto &ball : ballList )
+	{
+		if ( ball->GetOwner() == player )
+			ball->SetTexture( ballTexture );
+	}
+
+	for ( const auto &bullet : bulletList )
+	{
+		if ( bullet->GetOwner() == player )
+			bullet->SetTexture( ballTexture );
+	}
+
+	if ( !paddle )
+		return;
+
+	RenderHelpers::DestroyTexture( paddleTexture );
+	paddleTexture = RenderHelpers::InitSurface( paddle->rect, color, renderer );
+	paddle->SetTexture( paddleTexture );
+}
+void Renderer::CreateBonusBoxAtlas()
+{
+	// All boxes start out the same size, the scale is applied when they're drawn
+	BonusBox prototype( 0 );
+	int32_t boxSize = static_cast< int32_t > ( prototype.rect.w );
+
+	if ( !bonusBoxAtlas.Create( renderer, boxSize, colorConfig.localPlayerColor, colorConfig.remotePlayerColor, bonusTypeColors ) )
+		std::cout << "Renderer@" << __LINE__  << " Bonus boxes will not be drawn" << std::endl;
+}
+bool Renderer::HaveTileColorsChanged( const ColorConfigLoader &oldConfig ) const
+{
+	for ( uint64_t i = 0; i < tileTextures.size() ; ++i )
+	{
+		if ( oldConfig.GetTileColor( static_cast < TileType > ( i ) ) != GetTileColor( i ) )
+			return true;
+	}
+
+	for ( uint64_t i = 0; i < hardTileTextures.size() ; ++i )
+	{
+		if ( oldConfig.GetTileColor( TileType::Hard, i ) != GetHardTileColor( i ) )
+			return true;
+	}
+
+	return false;
+}
+void Renderer::ApplyColorConfig( const ColorConfigLoader &newConfig )
+{
+	ColorConfigLoader oldConfig = colorConfig;
+	std::map< BonusType, SDL_Color > oldBonusTypeColors = bonusTypeColors;
+
+	colorConfig = newConfig;
+	bonusTypeColors = colorConfig.GetBonusColorMap();
+
+	bool playerColorsChanged =
+			oldConfig.localPlayerColor != colorConfig.localPlayerColor
+		||	oldConfig.remotePlayerColor != colorConfig.remotePlayerColor;
+
+	if ( playerColorsChanged || oldBonusTypeColors != bonusTypeColors )
+		CreateBonusBoxAtlas();
+
+	// Particles and the HUD read the values when they're needed
+	if ( HaveTileColorsChanged( oldConfig ) )
+		CreateTileTextures();
+	else if ( oldConfig.backgroundColor != colorConfig.backgroundColor )
+		tileLayer.MarkAllDirty();
+
+	if ( oldConfig.localPlayerColor != colorConfig.localPlayerColor )
+		CreatePlayerTextures( Player::Local );
+
+	if ( oldConfig.remotePlayerColor != colorConfig.remotePlayerColor )
+		CreatePlayerTextures( Player::Remote );
+
+	if ( oldConfig.greyAreaColor != colorConfig.greyAreaColor )
+	{
+		greyArea.DestroyTexture();
+		greyArea.Init( renderer, colorConfig.greyAreaColor );
+	}
 }
 void Renderer::InitializeMainMenuTextures()
 {
@@ -266,33 +394,33 @@ void Renderer::LoadColors()
 // ============================================================================================
 void Renderer::AddTile( const std::shared_ptr< Tile > &tile )
 {
-	SDL_Texture* tileTexture = nullptr;
-
-	if ( tile->GetTileType() == TileType::Hard )
-		tileTexture = hardTileTextures[ 5 - tile->GetHitsLeft()];
-	else
-		tileTexture = tileTextures[ tile->GetTileTypeAsIndex() ];
-
-	tile->SetTexture( tileTexture );
+	tile->SetTexture( GetTileTexture( tile ) );
 
 	tileList.push_back( tile );
+	tileLayer.MarkDirty( viewTransform.ToScreen( tile->rect ) );
 }
 void Renderer::RemoveTile( const std::shared_ptr< Tile >  &tile )
 {
 	tileList.erase( std::find( tileList.begin(), tileList.end(), tile) );
+	tileLayer.MarkDirty( viewTransform.ToScreen( tile->rect ) );
 }
-void Renderer::UpdateTileHit( const std::shared_ptr< Tile >  &tile ) const
+void Renderer::UpdateTileHit( const std::shared_ptr< Tile >  &tile )
 {
 	if ( tile->GetTileType() != TileType::Hard )
 		return;
 
-	SDL_Texture* texture = hardTileTextures[ 5 - tile->GetHitsLeft()];
-	tile->SetTexture( texture );
+	tile->SetTexture( GetTileTexture( tile ) );
+	tileLayer.MarkDirty( viewTransform.ToScreen( tile->rect ) );
 }
 void Renderer::ClearBoard( )
 {
 	bulletList.erase( bulletList.begin(), bulletList.end() );
 	tileList.erase( tileList.begin(), tileList.end() );
+	tileLayer.MarkAllDirty();
+}
+void Renderer::InvalidateTileLayer()
+{
+	tileLayer.MarkAllDirty();
 }
 void Renderer::AddBall( const std::shared_ptr< Ball > &ball )
 {
@@ -301,7 +429,6 @@ void Renderer::AddBall( const std::shared_ptr< Ball > &ball )
 	else
 		ball->SetTexture( remotePlayerBallTexture );
 
-	ball->SetScale( scale );
 	ballList.push_back( ball );
 }
 void Renderer::RemoveBall(  const std::shared_ptr< Ball > &ball )
@@ -310,27 +437,9 @@ void Renderer::RemoveBall(  const std::shared_ptr< Ball > &ball )
 }
 void Renderer::AddBonusBox( const std::shared_ptr< BonusBox > &bonusBox )
 {
-	auto texture = CreateBonusBoxTexture( bonusBox );
-
-	bonusBox->SetTexture( texture ) ;
-	bonusBox->SetScale( scale );
-
+	// Drawn from bonusBoxAtlas, so there's no texture to create
 	bonusBoxList.push_back( bonusBox );
 }
-SDL_Texture* Renderer::CreateBonusBoxTexture( const std::shared_ptr< BonusBox >  &bb )
-{
-	SDL_Rect bonusBoxRect = bb->rect.ToSDLRect( );
-
-	SDL_Color color;
-	if ( bb->GetOwner() == Player::Local )
-		color = colorConfig.localPlayerColor;
-	else
-		color =  colorConfig.remotePlayerColor;
-
-	SDL_Color bonusColor = bonusTypeColors[ bb->GetBonusType() ];
-
-	return RenderHelpers::CreateBonusBoxTexture( renderer, bonusBoxRect, color, bonusColor );
-}
 void Renderer::RemoveBonusBox( const std::shared_ptr< BonusBox >  &bonusBox )
 {
 	bonusBoxList.erase( std::find( bonusBoxList.begin(), bonusBoxList.end(), bonusBox ) );
@@ -342,21 +451,37 @@ void Renderer::AddBullet( const std::shared_ptr< Bullet > &bullet )
 	else
 		bullet->SetTexture( remotePlayerBallTexture );
 
-	bullet->SetScale( scale );
-
 	bulletList.push_back( bullet );
 }
 void Renderer::RemoveBullet( const std::shared_ptr< Bullet >  &bullet )
 {
 	bulletList.erase( std::find( bulletList.begin(), bulletList.end(), bullet ) );
 }
+void Renderer::RemoveDeadPieces( const DeadPieces &dead )
+{
+	if ( !dead.balls.empty() )
+		Graveyard::Compact( ballList );
+
+	if ( !dead.tiles.empty() )
+	{
+		Graveyard::Compact( tileList );
+
+		for ( const auto &tile : dead.tiles )
+			tileLayer.MarkDirty( viewTransform.ToScreen( tile->rect ) );
+	}
+
+	if ( !dead.bullets.empty() )
+		Graveyard::Compact( bulletList );
+
+	if ( !dead.bonusBoxes.empty() )
+		Graveyard::Compact( bonusBoxList );
+}
 void Renderer::SetLocalPaddle( std::shared_ptr< Paddle >  &paddle )
 {
 	localPaddle = paddle;
 
 	localPlayerPaddle = RenderHelpers::InitSurface( localPaddle->rect, colorConfig.localPlayerColor, renderer );
 	localPaddle->SetTexture( localPlayerPaddle  );
-	localPaddle->SetScale( scale );
 	localPaddle->SetOriginalSize( localPaddle->rect.ToSDLRect() );
 }
 void Renderer::SetRemotePaddle( std::shared_ptr< Paddle >  &paddle )
@@ -365,14 +490,17 @@ void Renderer::SetRemotePaddle( std::shared_ptr< Paddle >  &paddle )
 
 	remotePlayerPaddle = RenderHelpers::InitSurface( localPaddle->rect, colorConfig.remotePlayerColor, renderer );
 	remotePaddle->SetTexture( remotePlayerPaddle );
-	remotePaddle->SetScale( scale );
 }
 // ============================================================================================
 // ================================= Renderering ==============================================
 // ============================================================================================
 void Renderer::Render( )
 {
-	SDL_RenderClear( renderer );
+	// Only recorded here, the frame is drawn by Draw(), on the render thread if there is one
+	frame.Clear();
+
+	frame.screen.SetDrawColor( colorConfig.backgroundColor );
+	frame.screen.RenderClear();
 
 	switch ( gameState )
 	{
@@ -399,51 +527,67 @@ void Renderer::Render( )
 			break;
 	}
 
+	if ( RenderThread::IsRunning() )
+		RenderThread::Publish( frame );
+	else
+		Draw( frame );
+}
+void Renderer::Draw( RenderFrame &frameToDraw )
+{
+	frameToDraw.targetUpdates.Play( renderer );
+	frameToDraw.screen.Play( renderer );
+
 	SDL_RenderPresent( renderer );
+
+	for ( auto texture : frameToDraw.deadTextures )
+		SDL_DestroyTexture( texture );
+
+	frameToDraw.Clear();
 }
 void Renderer::RenderMenu()
 {
-	RenderHelpers::RenderTextItem( renderer, mainMenuCaption  );
-	RenderHelpers::RenderTextItem( renderer, mainMenuSubCaption  );
-	RenderHelpers::RenderTextItem( renderer, greyArea  );
+	RenderHelpers::RenderTextItem( frame.screen, mainMenuCaption  );
+	RenderHelpers::RenderTextItem( frame.screen, mainMenuSubCaption  );
+	RenderHelpers::RenderTextItem( frame.screen, greyArea  );
 
 	if ( gameState == GameState::Lobby )
 		RenderLobbyFooter();
 	else if ( gameState == GameState::Options )
 	{
-		RenderHelpers::RenderConfigList( renderer, *configList, background );
-		RenderHelpers::RenderMenuItem( renderer, backToMenuButton);
+		RenderHelpers::RenderConfigList( frame.screen, *configList, background, optionsAtlas, colorConfig.GetTextColor() );
+		RenderHelpers::RenderMenuItem( frame.screen, backToMenuButton);
 	}
 	else
 		RenderMainMenuFooter();
 
-	RenderHelpers::SetDrawColor( renderer, colorConfig.backgroundColor  );
+	RenderHelpers::SetDrawColor( frame.screen, colorConfig.backgroundColor  );
 }
 void Renderer::RenderLobbyFooter()
 {
-	RenderHelpers::RenderMenuItem( renderer, lobbyNewGameButton );
-	RenderHelpers::RenderMenuItem( renderer, lobbyUpdateButton );
-	RenderHelpers::RenderMenuItem( renderer, lobbyBackButton );
-	RenderHelpers::RenderMenuList( renderer, *gameList, background );
+	RenderHelpers::RenderMenuItem( frame.screen, lobbyNewGameButton );
+	RenderHelpers::RenderMenuItem( frame.screen, lobbyUpdateButton );
+	RenderHelpers::RenderMenuItem( frame.screen, lobbyBackButton );
+	RenderHelpers::RenderMenuList( frame.screen, *gameList, background );
 }
 void Renderer::RenderMainMenuFooter()
 {
-	RenderHelpers::RenderMenuItem( renderer, singlePlayerButton);
-	RenderHelpers::RenderMenuItem( renderer, multiPlayerButton);
-	RenderHelpers::RenderMenuItem( renderer, optionsButton);
-	RenderHelpers::RenderMenuItem( renderer, quitButton);
+	RenderHelpers::RenderMenuItem( frame.screen, singlePlayerButton);
+	RenderHelpers::RenderMenuItem( frame.screen, multiPlayerButton);
+	RenderHelpers::RenderMenuItem( frame.screen, optionsButton);
+	RenderHelpers::RenderMenuItem( frame.screen, quitButton);
 }
 void Renderer::RenderPause()
 {
 	RenderGameObjects();
-	RenderHelpers::RenderMenuItem( renderer, pauseResumeButton );
-	RenderHelpers::RenderMenuItem( renderer, pauseMainMenuButton );
-	RenderHelpers::RenderMenuItem( renderer, pauseQuitButton );
+	RenderHelpers::RenderMenuItem( frame.screen, pauseResumeButton );
+	RenderHelpers::RenderMenuItem( frame.screen, pauseMainMenuButton );
+	RenderHelpers::RenderMenuItem( frame.screen, pauseQuitButton );
 }
 void Renderer::RenderGameObjects()
 {
+	// The layer covers the whole screen, background included, so everything else has to be drawn after it
+	tileLayer.Render( frame, tileList, viewTransform, colorConfig.backgroundColor );
 	RenderBalls();
-	RenderTiles();
 	RenderPaddles();
 	RenderBullets();
 	RenderBonusBoxes();
@@ -453,55 +597,50 @@ void Renderer::RenderGameObjects()
 void Renderer::RenderParticles()
 {
 	for ( const auto &p : particles )
-		RenderHelpers::RenderParticle( renderer, p );
+		RenderHelpers::RenderParticle( frame.screen, p );
 
-	RenderHelpers::SetDrawColor( renderer, colorConfig.backgroundColor);
+	RenderHelpers::SetDrawColor( frame.screen, colorConfig.backgroundColor);
 }
 void Renderer::RenderBalls()
 {
 	for ( std::shared_ptr< Ball > ball : ballList )
-		RenderHelpers::RenderGamePiece( renderer, ball );
-}
-void Renderer::RenderTiles()
-{
-	for ( std::shared_ptr< Tile > tile : tileList)
-		RenderHelpers::RenderGamePiece( renderer, tile );
+		RenderHelpers::RenderGamePiece( frame.screen, ball, viewTransform );
 }
 void Renderer::RenderPaddles()
 {
 	if ( localPaddle )
-		RenderHelpers::RenderGamePiece( renderer, localPaddle );
+		RenderHelpers::RenderGamePiece( frame.screen, localPaddle, viewTransform );
 
 	if ( isTwoPlayerMode && remotePaddle )
-		RenderHelpers::RenderGamePiece( renderer, remotePaddle );
+		RenderHelpers::RenderGamePiece( frame.screen, remotePaddle, viewTransform );
 }
 void Renderer::RenderBullets()
 {
 	for ( std::shared_ptr< Bullet > bullet : bulletList)
-		RenderHelpers::RenderGamePiece( renderer, bullet );
+		RenderHelpers::RenderGamePiece( frame.screen, bullet, viewTransform );
 }
 void Renderer::RenderBonusBoxes()
 {
-	for ( std::shared_ptr< BonusBox > bb : bonusBoxList)
-		RenderHelpers::RenderGamePiece( renderer, bb );
+	for ( const auto &bb : bonusBoxList )
+		bonusBoxAtlas.Render( frame.screen, *bb, viewTransform );
 }
 void Renderer::RenderText()
 {
-	RenderHelpers::RenderTextItem( renderer, localPlayerText );
+	RenderHelpers::RenderTextItem( frame.screen, localPlayerText );
 
-	RenderHelpers::RenderTextItem( renderer, levelNameText );
-	RenderHelpers::RenderTextItem( renderer, localPlayerCaption);
-	RenderHelpers::RenderTextItem( renderer, localPlayerPoints);
-	RenderHelpers::RenderTextItem( renderer, localPlayerLives );
-	RenderHelpers::RenderTextItem( renderer, localPlayerBalls );
+	RenderHelpers::RenderTextItem( frame.screen, levelNameText );
+	RenderHelpers::RenderTextItem( frame.screen, localPlayerCaption);
+	localPlayerPoints.Render( frame.screen, hudAtlas );
+	localPlayerLives.Render( frame.screen, hudAtlas );
+	localPlayerBalls.Render( frame.screen, hudAtlas );
 
 	if ( !isTwoPlayerMode )
 		return;
 
-	RenderHelpers::RenderTextItem( renderer, remotePlayerCaption );
-	RenderHelpers::RenderTextItem( renderer, remotePlayerLives );
-	RenderHelpers::RenderTextItem( renderer, remotePlayerPoints );
-	RenderHelpers::RenderTextItem( renderer, remotePlayerBalls );
+	RenderHelpers::RenderTextItem( frame.screen, remotePlayerCaption );
+	remotePlayerLives.Render( frame.screen, hudAtlas );
+	remotePlayerPoints.Render( frame.screen, hudAtlas );
+	remotePlayerBalls.Render( frame.screen, hudAtlas );
 }
 // ==============================================================================================
 // ================================= Text handling ==============================================
@@ -521,6 +660,19 @@ bool Renderer::LoadFontAndText()
 		return false;
 	}
 
+	if ( !hudAtlas.Create( renderer, font ) )
+		return false;
+
+	if ( !optionsAtlas.Create( renderer, tinyFont ) )
+		return false;
+
+	localPlayerLives.SetCaption( "Lives : " );
+	remotePlayerLives.SetCaption( "Lives : " );
+	localPlayerPoints.SetCaption( "Points : " );
+	remotePlayerPoints.SetCaption( "Points : " );
+	localPlayerBalls.SetCaption( "Balls : " );
+	remotePlayerBalls.SetCaption( "Balls : " );
+
 	return true;
 }
 void Renderer::RenderText( const std::string &textToRender, const Player &player, bool fade   )
@@ -572,68 +724,46 @@ void Renderer::RenderPlayerCaption( const std::string textToRender, const Player
 }
 void Renderer::RenderLives( uint64_t lifeCount, const Player &player )
 {
-	if ( player == Player::Local && localPlayerLives.NeedsUpdate( lifeCount ) )
+	if ( player == Player::Local )
 	{
-		localPlayerLives.value = lifeCount;
-
-		std::stringstream ss("");
-		ss << "Lives : " << lifeCount;
-
-		localPlayerLives.Reset( renderer, ss.str(), font, colorConfig.localPlayerColor );
+		localPlayerLives.color = colorConfig.localPlayerColor;
+		localPlayerLives.SetValue( lifeCount, hudAtlas );
 	}
-	else if ( player == Player::Remote && remotePlayerLives.NeedsUpdate( lifeCount ) )
+	else if ( player == Player::Remote )
 	{
-		remotePlayerLives.value = lifeCount;
-
-		std::stringstream ss;
-		ss << "Lives : " << lifeCount;
-
-		remotePlayerLives.Reset( renderer, ss.str(), font, colorConfig.remotePlayerColor );
+		remotePlayerLives.color = colorConfig.remotePlayerColor;
+		remotePlayerLives.SetValue( lifeCount, hudAtlas );
 	}
 }
 void Renderer::RenderPoints( uint64_t pointCount, const Player &player )
 {
-	if ( player == Player::Local && localPlayerPoints.NeedsUpdate( pointCount ) )
+	if ( player == Player::Local )
 	{
-		localPlayerPoints.value = pointCount;
-
-		std::stringstream ss("");
-		ss << "Points : " << pointCount;
-
-		localPlayerPoints.Reset( renderer, ss.str(), font, colorConfig.localPlayerColor );
+		localPlayerPoints.color = colorConfig.localPlayerColor;
+		localPlayerPoints.SetValue( pointCount, hudAtlas );
 	}
-	else if ( player == Player::Remote && remotePlayerPoints.NeedsUpdate( pointCount ) )
+	else if ( player == Player::Remote )
 	{
-		remotePlayerPoints.value  = pointCount;
-
-		std::stringstream ss("");
-		ss << "Points : " << pointCount;
+		remotePlayerPoints.color = colorConfig.remotePlayerColor;
 
-		remotePlayerPoints.Reset( renderer, ss.str(), font, colorConfig.remotePlayerColor );
-
-		CalculateRemotePlayerTextureRects();
+		// The remote values are right aligned, so they move when they get wider
+		if ( remotePlayerPoints.SetValue( pointCount, hudAtlas ) )
+			CalculateRemotePlayerTextureRects();
 	}
 }
 void Renderer::RenderBallCount( uint64_t  ballCount, const Player &player )
 {
-	if ( player == Player::Local && localPlayerBalls.NeedsUpdate( ballCount ) )
+	if ( player == Player::Local )
 	{
-		localPlayerBalls.value = ballCount;
-
-		std::stringstream ss("");
-		ss << "Balls : " <<  ballCount;
-
-		localPlayerBalls.Reset( renderer, ss.str(), font, colorConfig.localPlayerColor );
-	} else if ( player == Player::Remote && remotePlayerBalls.NeedsUpdate( ballCount ))
+		localPlayerBalls.color = colorConfig.localPlayerColor;
+		localPlayerBalls.SetValue( ballCount, hudAtlas );
+	}
+	else if ( player == Player::Remote )
 	{
-		remotePlayerBalls.value =  ballCount;
+		remotePlayerBalls.color = colorConfig.remotePlayerColor;
 
-		std::stringstream ss("");
-		ss << "Balls : " << ballCount;
-
-		remotePlayerBalls.Reset( renderer, ss.str(), font, colorConfig.remotePlayerColor );
-
-		CalculateRemotePlayerTextureRects();
+		if ( remotePlayerBalls.SetValue( ballCount, hudAtlas ) )
+			CalculateRemotePlayerTextureRects();
 	}
 }
 void Renderer::ResetText()
@@ -690,6 +820,14 @@ std::shared_ptr< MenuItem > Renderer::AddMenuButtonHelper( std::string menuItemS
 	std::shared_ptr< MenuItem > menuItem = std::make_shared< MenuItem >( menuItemString );
 
 	menuItem->SetTexture( RenderHelpers::RenderTextTexture_Blended( textFont, menuItemString, colorConfig.textColor, r, renderer ) );
+
+	SDL_Rect selectedRect;
+	SDL_Color selectedColor = { 0, 200, 200, 255 };
+	int style = TTF_STYLE_UNDERLINE | TTF_STYLE_ITALIC;
+
+	SDL_Texture* selected = RenderHelpers::RenderTextTexture_Blended( textFont, menuItemString, selectedColor, selectedRect, renderer, style );
+	menuItem->SetSelectedTexture( selected, selectedRect.w, selectedRect.h );
+
 	r.x = singlePlayerRect.x + singlePlayerRect.w + margin;
 	r.y = singlePlayerRect.y;
 
@@ -713,57 +851,40 @@ void Renderer::AddOptionsButtonHelper( std::string caption, ConfigValueType type
 	optionsItem->SetIsBool( isBool );
 
 	// Value
-	SDL_Rect valueRect;
 	std::string value = "0";
 	if ( isBool )
 		value = "FALSE";
 
-	SDL_Texture* valueTexture = RenderHelpers::RenderTextTexture_Blended( tinyFont, value, colorConfig.textColor, valueRect, renderer );
+	SDL_Rect valueRect;
 	valueRect.x = captionRect.x + captionRect.w + ( margin / 2);
 	valueRect.y = captionRect.y;
+	valueRect.w = optionsAtlas.GetTextWidth( value );
+	valueRect.h = optionsAtlas.GetHeight();
 
 	optionsItem->SetValueRect( valueRect );
-	optionsItem->SetValueTexture( valueTexture );
+	optionsItem->SetValueText( value );
 
 	configList->AddConfigItem( optionsItem, type );
 
 	return;
 }
-void Renderer::SetUnderlineHelper( const std::shared_ptr< MenuItem > &menuItem )
-{
-	if ( !menuItem || !menuItem->HasValidTexture() || !menuItem->HasUnderlineChanged()  )
-		return;
-
-	SDL_Color clr = colorConfig.textColor;
-	int style = 0;
-
-	if ( menuItem->IsSelected()  )
-	{
-		clr = SDL_Color{ 0, 200, 200, 255};
-		style = TTF_STYLE_UNDERLINE | TTF_STYLE_ITALIC;
-	}
-
-	SDL_Rect r = menuItem->GetRect();
-	menuItem->SetTexture( RenderHelpers::RenderTextTexture_Blended( mediumFont, menuItem->GetName(), clr, r, renderer, style ) );
-	menuItem->SetRect( r );
-}
 void Renderer::UpdateConfigValue( const std::shared_ptr< ConfigItem > &item )
 {
 	if ( !item->HasChanged() )
 		return;
 
-	SDL_Rect r = item->GetValueRect();
-	std::stringstream ss("");
-	
+	std::string value;
+
 	if ( item->IsBool() )
-		ss << std::boolalpha << item->GetBool();
+		value = item->GetBool() ? "true" : "false";
 	else
-		ss << item->GetValue();
+		value = std::to_string( item->GetValue() );
+
+	SDL_Rect r = item->GetValueRect();
+	r.w = optionsAtlas.GetTextWidth( value );
+	r.h = optionsAtlas.GetHeight();
 
-	item->SetValueTexture
-	(
-		RenderHelpers::RenderTextTexture_Blended( tinyFont, ss.str(), colorConfig.GetTextColor(), r, renderer, 0 )
-	);
+	item->SetValueText( value );
 	item->SetValueRect( r );
 }
 void Renderer::CenterMainMenuButtons( )
@@ -927,46 +1048,34 @@ void Renderer::Update( double delta )
 			++p;
 	}
 
-	auto configItems = configList->GetConfigList();
-	for ( const auto &p : configItems )
-		UpdateConfigValue( configItems[ p.first ]);
+	for ( const auto &p : configList->GetConfigList() )
+		UpdateConfigValue( p.second );
 
 	localPlayerText.Update( delta );
-
-	SetUnderlineHelper( backToMenuButton );
-
-	// Main menu mode
-	// =============================================
-	SetUnderlineHelper( singlePlayerButton  );
-	SetUnderlineHelper( multiPlayerButton  );
-	SetUnderlineHelper( optionsButton  );
-	SetUnderlineHelper( quitButton  );
-
-	// Pause menu mode
-	// =============================================
-	SetUnderlineHelper( pauseResumeButton );
-	SetUnderlineHelper( pauseMainMenuButton );
-	SetUnderlineHelper( pauseQuitButton );
-
-	// MultiplayerButton menu item
-	// =============================================
-	SetUnderlineHelper( lobbyNewGameButton );
-	SetUnderlineHelper( lobbyUpdateButton );
-	SetUnderlineHelper( lobbyBackButton );
 }
 void Renderer::GenerateParticleEffect( std::shared_ptr< Tile > tile )
 {
 	Rect r( 0,0,10,10 );
-	Vector2f pos = RectHelpers::CenterInRect( tile->rect, r );
+	Rect tileRect;
+	tileRect.FromSDLRect( viewTransform.ToScreen( tile->rect ) );
+	Vector2f pos = RectHelpers::CenterInRect( tileRect, r );
 	SDL_Color color = GetTileColor( tile );
 
-	//for ( int i = 0; i < colorConfig.particleFireCount ; ++i )
-	for ( int i = 0; i < 1 ; ++i )
+	//const size_t count = static_cast< size_t > ( colorConfig.particleFireCount );
+	const size_t count = 1;
+
+	// Four random numbers per particle : x and y direction, decay and speed. All of them are generated in one go
+	particleRandom.resize( count * 4 );
+
+	RandomGenerator &random = RandomService::Get( RandomStream::Particles );
+	random.Fill( &particleRandom[ 0 ], count * 2, -1.0, 1.0 );
+	random.Fill( &particleRandom[ count * 2 ], count, colorConfig.particleDecayMin, colorConfig.particleDecayMax );
+	random.Fill( &particleRandom[ count * 3 ], count, colorConfig.particleSpeedMin, colorConfig.particleSpeedMax );
+
+	for ( size_t i = 0; i < count ; ++i )
 	{
-		auto p = Particle( Rect( pos.x, pos.y, 10, 10 ), color  );
-		p.SetDecay( colorConfig.particleDecayMin, colorConfig.particleDecayMax );
-		p.SetSpeed( colorConfig.particleSpeedMin, colorConfig.particleSpeedMax );
-		particles.push_back( p );
+		Vector2f dir( particleRandom[ i * 2 ], particleRandom[ i * 2 + 1 ] );
+		particles.push_back( Particle( Rect( pos.x, pos.y, 10, 10 ), color, dir, particleRandom[ count * 2 + i ], particleRandom[ count * 3 + i ] ) );
 	}
 }
 // ==============================================================================================
@@ -995,8 +1104,10 @@ void Renderer::CleanUpSurfaces()
 	// Free text surfaces
 	localPlayerText.DestroyTexture();
 	SDL_DestroyTexture( localPlayerCaption.texture );
-	SDL_DestroyTexture( localPlayerLives.texture );
-	SDL_DestroyTexture( localPlayerPoints.texture );
+	hudAtlas.Destroy();
+	optionsAtlas.Destroy();
+	bonusBoxAtlas.Destroy();
+	tileLayer.Destroy();
 }
 void Renderer::CleanUpLists()
 {
@@ -1098,7 +1209,7 @@ const std::shared_ptr< MenuItem > &Renderer::GetPauseMenuItem( const PauseMenuIt
 			return pauseQuitButton;
 	}
 }
-void Renderer::SetScale( double scale_ )
+const ViewTransform &Renderer::GetViewTransform() const
 {
-	scale = scale_;
+	return viewTransform;
 }
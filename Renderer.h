@@ -16,6 +16,13 @@
 
 #include "structs/rendering/Particle.h"
 #include "structs/rendering/RenderingItem.h"
+#include "structs/rendering/GlyphAtlas.h"
+#include "structs/rendering/GlyphText.h"
+#include "structs/rendering/BonusBoxAtlas.h"
+#include "structs/rendering/TileLayer.h"
+#include "structs/rendering/RenderFrame.h"
+
+#include "math/ViewTransform.h"
 
 #include "structs/menu_items/ConfigItem.h"
 #include "structs/menu_items/ConfigList.h"
@@ -29,6 +36,7 @@ struct Tile;
 struct Bullet;
 struct Paddle;
 struct BonusBox;
+struct DeadPieces;
 struct MenuList;
 struct MainMenuItem;;
 struct PauseMenuItem;
@@ -51,8 +59,14 @@ public:
 
 	void AddTile( const std::shared_ptr< Tile > &tile );
 	void RemoveTile( const std::shared_ptr< Tile >  &tile );
-	void UpdateTileHit( const std::shared_ptr< Tile >  &tile ) const;
+	void UpdateTileHit( const std::shared_ptr< Tile >  &tile );
 	void ClearBoard( );
+	// Needed when SDL has thrown away the contents of render targets, like after the device is reset
+	void InvalidateTileLayer();
+
+	// ColorCfg.txt has changed while the game is running. Only the textures with new colors are created again
+	// Text that already exists keeps its old colors
+	void ApplyColorConfig( const ColorConfigLoader &newConfig );
 
 	void AddBall( const std::shared_ptr< Ball > &ball );
 	void RemoveBall( const std::shared_ptr< Ball >  &ball );
@@ -63,10 +77,16 @@ public:
 	void AddBullet( const std::shared_ptr< Bullet > &bb );
 	void RemoveBullet( const std::shared_ptr< Bullet >  &bb );
 
+	// One pass over each list that has lost something, instead of one search per dead piece
+	void RemoveDeadPieces( const DeadPieces &dead );
+
 	void SetLocalPaddle( std::shared_ptr< Paddle >  &paddle );
 	void SetRemotePaddle( std::shared_ptr< Paddle >  &paddle );
 
+	// Records the frame, then publishes it to the RenderThread if it's running, or draws it right away
 	void Render( );
+	// Render thread, plays a recorded frame back and presents it
+	void Draw( RenderFrame &frameToDraw );
 	void Update( double delta );
 
 	void SetGameState( const GameState &gs );
@@ -122,7 +142,8 @@ public:
 	void AddGameToList( GameInfo gameInfo );
 	void ClearGameList();
 
-	void SetScale( double scale_ );
+	// Maps the field the game is played on to the screen, and the mouse back
+	const ViewTransform &GetViewTransform() const;
 
 	const std::shared_ptr< ConfigList> &GetConfigList()
 	{
@@ -141,7 +162,6 @@ private:
 	Renderer( const Renderer &renderer );
 	Renderer& operator=( const Renderer &renderer );
 
-	SDL_Texture* CreateBonusBoxTexture( const std::shared_ptr< BonusBox >  &bb );
 	SDL_Color GetBonusBoxColor( const BonusType &bonusType );
 
 	void Setup();
@@ -159,7 +179,6 @@ private:
 
 	void RenderText();
 	void RenderBalls();
-	void RenderTiles();
 	void RenderPaddles();
 	void RenderBullets();
 	void RenderBonusBoxes();
@@ -176,6 +195,11 @@ private:
 	bool LoadAssets();
 	void LoadColors();
 	bool InitializeTextures();
+	void CreateTileTextures();
+	SDL_Texture* GetTileTexture( const std::shared_ptr< Tile > &tile ) const;
+	void CreatePlayerTextures( const Player &player );
+	void CreateBonusBoxAtlas();
+	bool HaveTileColorsChanged( const ColorConfigLoader &oldConfig ) const;
 	void InitializeMainMenuTextures();
 
 	void PrintSDL_TTFVersion();
@@ -191,7 +215,6 @@ private:
 	void CenterMainMenuButtons( );
 	void CenterOptionsButtons( );
 
-	void SetUnderlineHelper( const std::shared_ptr< MenuItem > &menuItem );
 	void UpdateConfigValue ( const std::shared_ptr< ConfigItem > &item );
 	void InitGreyAreaRect( );
 	void AddMainMenuButton( const std::string &singlePlayerString, const MainMenuItemType &mit );
@@ -234,6 +257,11 @@ private:
 	std::vector< SDL_Texture* > tileTextures;
 	std::vector< SDL_Texture* > hardTileTextures;
 
+	TileLayer tileLayer;
+
+	// The frame being recorded
+	RenderFrame frame;
+
 	// Text
 	// =============================================
 	TTF_Font* tinyFont;
@@ -242,6 +270,11 @@ private:
 	TTF_Font* bigFont;
 	TTF_Font* hugeFont;
 
+	// Every glyph of font, so the HUD values below can change without rendering any new text
+	GlyphAtlas hudAtlas;
+	// Every glyph of tinyFont, for the values in the options list
+	GlyphAtlas optionsAtlas;
+
 	// Main info text...
 	RenderingItem< std::string > localPlayerText;
 
@@ -253,19 +286,19 @@ private:
 	RenderingItem< std::string > remotePlayerCaption;
 
 	// Lives
-	RenderingItem< uint64_t > localPlayerLives;
-	RenderingItem< uint64_t > remotePlayerLives;
+	GlyphText localPlayerLives;
+	GlyphText remotePlayerLives;
 
 	// Points
-	RenderingItem< uint64_t > localPlayerPoints;
-	RenderingItem< uint64_t > remotePlayerPoints;
+	GlyphText localPlayerPoints;
+	GlyphText remotePlayerPoints;
 
 	// Balls
-	RenderingItem< uint64_t > localPlayerBalls;
-	RenderingItem< uint64_t > remotePlayerBalls;
+	GlyphText localPlayerBalls;
+	GlyphText remotePlayerBalls;
 
 	short margin;
-	double scale;
+	ViewTransform viewTransform;
 
 	SDL_Texture*   mainMenuBackground;
 
@@ -304,6 +337,8 @@ private:
 
 	// Bonus Boxes
 	std::map< BonusType, SDL_Color > bonusTypeColors;
+	BonusBoxAtlas bonusBoxAtlas;
 
 	std::vector< Particle > particles;
+	std::vector< double > particleRandom;
 };
@@ -5,9 +5,19 @@ SOURCES += ../structs/game_objects/Paddle.cpp
 SOURCES += ../structs/game_objects/Bullet.cpp
 SOURCES += ../structs/game_objects/Tile.cpp
 SOURCES += ../structs/game_objects/Ball.cpp
+SOURCES += ../structs/game_objects/TileColumns.cpp
+SOURCES += ../structs/game_objects/TileTracker.cpp
+SOURCES += ../structs/game_objects/Graveyard.cpp
 SOURCES += ../structs/rendering/Particle.cpp
+SOURCES += ../structs/rendering/GlyphAtlas.cpp
+SOURCES += ../structs/rendering/BonusBoxAtlas.cpp
+SOURCES += ../structs/rendering/TileLayer.cpp
+SOURCES += ../structs/rendering/DrawList.cpp
 SOURCES += ../structs/net/TCPConnection.cpp
 SOURCES += ../structs/net/TCPMessage.cpp
+SOURCES += ../structs/net/TCPMessageParser.cpp
+SOURCES += ../structs/net/UDPConnection.cpp
+SOURCES += ../structs/net/NetworkSimulator.cpp
 SOURCES += ../structs/board/TilePosition.cpp
 SOURCES += ../structs/board/Board.cpp
 SOURCES += ../structs/menu_items/List.cpp
@@ -18,14 +28,27 @@ SOURCES += ../structs/menu_items/ConfigItem.cpp
 SOURCES += ../structs/menu_items/MainMenuItem.cpp
 SOURCES += ../structs/menu_items/PauseMenuItem.cpp
 SOURCES += ../tools/RenderTools.cpp
+SOURCES += ../tools/Benchmark.cpp
+SOURCES += ../tools/BallStorm.cpp
+SOURCES += ../tools/ReplayPlayer.cpp
+SOURCES += ../tools/ReplayRecorder.cpp
+SOURCES += ../tools/SimulationMatch.cpp
+SOURCES += ../tools/SimulationFarm.cpp
+SOURCES += ../tools/WorkStealingPool.cpp
+SOURCES += ../tools/RenderThread.cpp
+SOURCES += ../tools/ConfigWatcher.cpp
 SOURCES += ../math/Vector2f.cpp
 SOURCES += ../math/VectorHelpers.cpp
 SOURCES += ../math/Rect.cpp
+SOURCES += ../math/RandomService.cpp
+SOURCES += ../math/ViewTransform.cpp
 SOURCES += ../Timer.cpp
 SOURCES += ../Renderer.cpp
 SOURCES += ../GameManager.cpp
 SOURCES += ../PhysicsManager.cpp
+SOURCES += ../GameRules.cpp
 SOURCES += ../BoardLoader.cpp
+SOURCES += ../BoardGenerator.cpp
 SOURCES += ../MenuManager.cpp
 SOURCES += ../NetManager.cpp
 SOURCES += ../ColorConfigLoader.cpp
@@ -42,8 +65,10 @@ LIBS = -lSDL2
 LIBS += -lSDL2_net
 LIBS += -lSDL2_ttf
 LIBS += -lSDL2_image
+LIBS += -pthread
 
 QMAKE_CXXFLAGS = -std=c++11
+QMAKE_CXXFLAGS += -pthread
 
 QMAKE_CXXFLAGS += -Weverything
 QMAKE_CXXFLAGS += -Wno-c++98-compat
@@ -19,4 +19,5 @@ enum class BonusType
 
 	BonusSteal, // Steal all bonuses from oponent.
 
+	Count // Number of bonus types, used to size arrays indexed by BonusType
 };
@@ -12,9 +12,21 @@ enum class ConfigValueType
 
 	FastMode,		// Bool
 
+	AIPaddleSpeed,
+
 	PointsHit,
 	PointsHard,
 	PointsRegular,
 	PointsExplosive,
 	PointsUnbreakable,
+
+	// Network simulation
+	NetLatency,
+	NetJitter,
+	NetBandwidth,
+	NetReorderChance,
+	NetLossChance,
+	NetDisconnectAfter,
+
+	Count // Number of values, used to size arrays indexed by ConfigValueType
 };
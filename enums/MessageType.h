@@ -33,4 +33,9 @@ enum MessageType
 	BulletKilled,		// Bullet fired from opnent was killed
 
 	LevelName,			// Bullet fired from opnent was killed
+
+	Ping,				// Contains the senders ticks, answered with a Pong
+	Pong,				// Contains the senders ticks and the ticks of the Ping it answers
+
+	UDPHandshake,		// Contains the UDP port of the sender. Paddle and ball data is sent over UDP once both players have sent this
 };
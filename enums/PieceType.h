@@ -0,0 +1,11 @@
+#pragma once
+
+// The kinds of pieces that can die during a game, see Graveyard
+enum class PieceType
+{
+	Ball,
+	Tile,
+	Bullet,
+	BonusBox,
+	Count // Number of piece types, used to size arrays indexed by PieceType
+};
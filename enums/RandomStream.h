@@ -0,0 +1,12 @@
+#pragma once
+
+// Every part of the game gets its own sequence of random numbers from RandomService
+// That way drawing more particles or simulating a bad network doesn't change where the balls go
+enum class RandomStream
+{
+	Gameplay,	// Balls and bonuses
+	AI,
+	Particles,
+	Network,	// NetworkSimulator
+	Count
+};
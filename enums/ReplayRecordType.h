@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+// What the next part of a replay file contains. Written as a single byte in front of every record
+enum class ReplayRecordType : uint8_t
+{
+	Tick,		// Start of a frame : delta and game time
+	Event,		// Mouse, keyboard and joystick button events
+	Joystick,	// Joystick direction, only written when it's not in the middle
+	NetState,	// Whether the game was connected when it checked
+	Message,	// A message recieved from the oponent or the main server
+	Board,		// The tiles of a new board
+	Checksum,	// End of a frame : checksum of the game state, used to find desyncs
+	End
+};
@@ -1,10 +1,15 @@
 #include <iostream>
 #include <algorithm>
 #include <string>
+#include <vector>
+#include <utility>
 
 #include "GameManager.h"
 #include "math/Rect.h"
 #include "NetManager.h"
+#include "tools/Benchmark.h"
+#include "tools/SimulationFarm.h"
+#include "math/RandomService.h"
 
 std::string Replace( const std::string &str, char replace, char replaceWith );
 std::string ReplaceUnderscores( const std::string &str );
@@ -34,6 +39,25 @@ int main( int argc, char* args[] )
 	bool startTwoPlayer = false;
 	bool isServer = false;
 	bool isAIControlled = false;
+	bool useUDP = false;
+	bool useRenderThread = true;
+
+	// Network simulation, overrides the values from Config.txt
+	std::vector< std::pair< ConfigValueType, double > > netOverrides;
+
+	std::string recordFile = "";
+	std::string replayFile = "";
+	bool headless = false;
+
+	std::string benchmark = "";
+	uint32_t benchmarkCount = 0;
+
+	std::string board = "";
+	uint32_t ballStormCount = 0;
+
+	uint32_t simulateCount = 0;
+	uint32_t threadCount = 0;
+	uint64_t seed = RandomService::GenerateSeed();
 
 	std::cout << "Args : \n";
 
@@ -63,9 +87,54 @@ int main( int argc, char* args[] )
 				port = static_cast<unsigned short >( std::stoi( args[ i + 1 ] ) );
 			else if ( str == "-aicontrolled" && argc > ( i + 1 ) )
 				isAIControlled = StrToBool( args[ i + 1 ]);
+			else if ( str == "-udp" && argc > ( i + 1 ) )
+				useUDP = StrToBool( args[ i + 1 ]);
+			else if ( str == "-renderthread" && argc > ( i + 1 ) )
+				useRenderThread = StrToBool( args[ i + 1 ]);
+			else if ( str == "-netlatency" && argc > ( i + 1 ) )
+				netOverrides.push_back( std::make_pair( ConfigValueType::NetLatency, std::stod( args[ i + 1 ] ) ) );
+			else if ( str == "-netjitter" && argc > ( i + 1 ) )
+				netOverrides.push_back( std::make_pair( ConfigValueType::NetJitter, std::stod( args[ i + 1 ] ) ) );
+			else if ( str == "-netbandwidth" && argc > ( i + 1 ) )
+				netOverrides.push_back( std::make_pair( ConfigValueType::NetBandwidth, std::stod( args[ i + 1 ] ) ) );
+			else if ( str == "-netreorder" && argc > ( i + 1 ) )
+				netOverrides.push_back( std::make_pair( ConfigValueType::NetReorderChance, std::stod( args[ i + 1 ] ) ) );
+			else if ( ( str == "-netloss" || str == "-udploss" ) && argc > ( i + 1 ) )
+				netOverrides.push_back( std::make_pair( ConfigValueType::NetLossChance, std::stod( args[ i + 1 ] ) ) );
+			else if ( str == "-netdisconnect" && argc > ( i + 1 ) )
+				netOverrides.push_back( std::make_pair( ConfigValueType::NetDisconnectAfter, std::stod( args[ i + 1 ] ) ) );
+			else if ( str == "-record" && argc > ( i + 1 ) )
+				recordFile = args[ i + 1 ];
+			else if ( str == "-replay" && argc > ( i + 1 ) )
+				replayFile = args[ i + 1 ];
+			else if ( str == "-headless" && argc > ( i + 1 ) )
+				headless = StrToBool( args[ i + 1 ]);
+			else if ( str == "-benchmark" && argc > ( i + 1 ) )
+				benchmark = ToLower( args[ i + 1 ] );
+			else if ( str == "-benchmarkcount" && argc > ( i + 1 ) )
+				benchmarkCount = static_cast< uint32_t >( std::stoul( args[ i + 1 ] ) );
+			else if ( str == "-board" && argc > ( i + 1 ) )
+				board = args[ i + 1 ];
+			else if ( str == "-ballstorm" && argc > ( i + 1 ) )
+				ballStormCount = static_cast< uint32_t >( std::stoul( args[ i + 1 ] ) );
+			else if ( str == "-simulate" && argc > ( i + 1 ) )
+				simulateCount = static_cast< uint32_t >( std::stoul( args[ i + 1 ] ) );
+			else if ( str == "-threads" && argc > ( i + 1 ) )
+				threadCount = static_cast< uint32_t >( std::stoul( args[ i + 1 ] ) );
+			else if ( str == "-seed" && argc > ( i + 1 ) )
+				seed = std::stoull( args[ i + 1 ] );
 		}
 	}
 
+	if ( !benchmark.empty() )
+		return Benchmark::Run( benchmark, benchmarkCount, board ) ? 0 : 1;
+
+	if ( simulateCount > 0 )
+	{
+		SimulationFarm farm( threadCount );
+		return farm.Run( simulateCount, seed ) ? 0 : 1;
+	}
+
 	localPlayerName = ReplaceUnderscores( localPlayerName );
 
 	std::cout << "========== CONFIG ==========\n";
@@ -78,14 +147,37 @@ int main( int argc, char* args[] )
 	std::cout << "IP               : " << ip << std::endl;
 	std::cout << "Port             : " << port << std::endl;
 	std::cout << "AI Controlled    : " << isAIControlled << std::endl;
+	std::cout << "UDP              : " << std::boolalpha << useUDP << std::endl;
+	std::cout << "Render thread    : " << std::boolalpha << useRenderThread << std::endl;
+	std::cout << "Net overrides    : " << netOverrides.size() << std::endl;
+	std::cout << "Record to        : " << recordFile << std::endl;
+	std::cout << "Replay           : " << replayFile << std::endl;
+	std::cout << "Headless         : " << std::boolalpha << headless << std::endl;
+	std::cout << "Board            : " << board << std::endl;
+	std::cout << "Ball storm       : " << ballStormCount << std::endl;
 	std::cout << "============================\n";
 
 	GameManager gameMan;
+	if ( !replayFile.empty() && !gameMan.LoadReplay( replayFile, headless ) )
+		return 1;
+
+	gameMan.SetRecordFile( recordFile );
+
 	if ( !gameMan.Init( localPlayerName, resolution, startFS  ) )
 		return 1;
 
 	gameMan.SetFPSLimit( fpsLimit );
 	gameMan.SetAIControlled( isAIControlled );
+	gameMan.SetUseUDP( useUDP );
+	gameMan.SetUseRenderThread( useRenderThread );
+	gameMan.SetBoard( board );
+
+	if ( ballStormCount > 0 )
+		gameMan.SetBallStorm( ballStormCount );
+
+	for ( const auto &p : netOverrides )
+		gameMan.OverrideConfig( p.first, p.second );
+
 	gameMan.InitNetManager( ip, port );
 	gameMan.Run();
 	return 0;
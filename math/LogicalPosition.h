@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <iostream>
+
+#include "Rect.h"
+#include "Vector2f.h"
+#include "ViewTransform.h"
+
+// A position in the field ( see ViewTransform ), the way it's sent to the other player
+// Fixed point with fractionBits bits below each unit, so it can be sent as two integers
+struct LogicalPosition
+{
+	static const int32_t fractionBits = 8;
+	static const int32_t one = 1 << fractionBits;
+
+	LogicalPosition()
+		:	x( 0 )
+		,	y( 0 )
+	{
+	}
+	LogicalPosition( int32_t x_, int32_t y_ )
+		:	x( x_ )
+		,	y( y_ )
+	{
+	}
+
+	static LogicalPosition FromField( const Vector2f &pos )
+	{
+		return LogicalPosition( ToFixed( pos.x ), ToFixed( pos.y ) );
+	}
+	// The top left of rect, seen from the other side of the field. The bottom of this field is the top of the other player's
+	static LogicalPosition FromFieldFlipped( const Rect &rect )
+	{
+		return LogicalPosition( ToFixed( rect.x ), ToFixed( ViewTransform::fieldHeight - ( rect.y + rect.h ) ) );
+	}
+	Vector2f ToField() const
+	{
+		return Vector2f( static_cast< double > ( x ) / one, static_cast< double > ( y ) / one );
+	}
+
+	int32_t x;
+	int32_t y;
+
+	private:
+	static int32_t ToFixed( double value )
+	{
+		return static_cast< int32_t > ( std::lround( value * one ) );
+	}
+};
+
+// Written like Vector2f, 'x, y'
+inline std::istream& operator>>( std::istream &is, LogicalPosition &pos )
+{
+	char ch;
+	is >> pos.x >> ch >> pos.y;
+	return is;
+}
+inline std::ostream& operator<<( std::ostream &os, const LogicalPosition &pos )
+{
+	os << pos.x << ", " << pos.y;
+	return os;
+}
+inline bool operator==( const LogicalPosition &pos1, const LogicalPosition &pos2 )
+{
+	return ( pos1.x == pos2.x ) && ( pos1.y == pos2.y );
+}
+inline bool operator!=( const LogicalPosition &pos1, const LogicalPosition &pos2 )
+{
+	return !( pos1 == pos2 );
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// xoshiro256** ( http://prng.di.unimi.it/ )
+// Much smaller and faster than std::mt19937, and good enough for a game. The same seed always gives the same numbers
+class RandomGenerator
+{
+	public:
+	RandomGenerator()
+	{
+		Seed( 0 );
+	}
+	void Seed( uint64_t seed )
+	{
+		// The state is filled with splitmix64, as recommended by the authors of xoshiro. Avoids an all zero state
+		for ( auto &s : state )
+		{
+			seed += 0x9E3779B97F4A7C15ULL;
+
+			uint64_t z = seed;
+			z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+			z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+			s = z ^ ( z >> 31 );
+		}
+	}
+	uint64_t Next()
+	{
+		const uint64_t result = RotateLeft( state[1] * 5, 7 ) * 9;
+		const uint64_t t = state[1] << 17;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+
+		state[2] ^= t;
+		state[3] = RotateLeft( state[3], 45 );
+
+		return result;
+	}
+	// [ 0, 1 )
+	double NextDouble()
+	{
+		// The 53 highest bits fill the mantissa of a double exactly
+		return static_cast< double > ( Next() >> 11 ) * ( 1.0 / 9007199254740992.0 );
+	}
+	// [ min, max )
+	double GenRandomNumber( double min, double max )
+	{
+		return min + ( max - min ) * NextDouble();
+	}
+	// [ 1, max ]
+	int GenRandomNumber( int max )
+	{
+		if ( max <= 1 )
+			return 1;
+
+		// Multiply and shift instead of %, the bias is far too small to matter for ranges this size
+		uint64_t range = static_cast< uint64_t > ( max );
+		return 1 + static_cast< int > ( ( ( Next() >> 32 ) * range ) >> 32 );
+	}
+	// [ 1, max )
+	double GenRandomNumber( double max )
+	{
+		return GenRandomNumber( 1.0, max );
+	}
+	// Fills values with numbers in [ min, max ), for when many numbers are needed at once ( like particles )
+	void Fill( double* values, size_t count, double min, double max )
+	{
+		const double range = max - min;
+
+		for ( size_t i = 0; i < count; ++i )
+			values[i] = min + range * NextDouble();
+	}
+	private:
+	static uint64_t RotateLeft( uint64_t x, int k )
+	{
+		return ( x << k ) | ( x >> ( 64 - k ) );
+	}
+
+	uint64_t state[4];
+};
@@ -0,0 +1,54 @@
+#include "RandomService.h"
+
+#include <random>
+
+namespace
+{
+	thread_local RandomService* currentService = nullptr;
+}
+
+RandomService::RandomService()
+	:	RandomService( GenerateSeed() )
+{
+}
+RandomService::RandomService( uint64_t seed_ )
+	:	seed( seed_ )
+{
+	Seed( seed_ );
+}
+void RandomService::Seed( uint64_t seed_ )
+{
+	seed = seed_;
+
+	// Each stream gets its own seed, spread out by splitmix64 in RandomGenerator::Seed
+	// That makes the streams look unrelated, but nothing stops them from overlapping somewhere in the period
+	// Stream i of seed s is also stream 0 of seed s + i * 0xD1B54A32D192ED03
+	for ( int i = 0; i < static_cast< int > ( RandomStream::Count ); ++i )
+		generators[i].Seed( seed + static_cast< uint64_t > ( i ) * 0xD1B54A32D192ED03ULL );
+}
+uint64_t RandomService::GetSeed() const
+{
+	return seed;
+}
+RandomGenerator &RandomService::GetGenerator( RandomStream stream )
+{
+	return generators[ static_cast< int > ( stream ) ];
+}
+RandomService &RandomService::Current()
+{
+	if ( currentService != nullptr )
+		return *currentService;
+
+	static thread_local RandomService threadService;
+	return threadService;
+}
+void RandomService::SetCurrent( RandomService* service )
+{
+	currentService = service;
+}
+uint64_t RandomService::GenerateSeed()
+{
+	std::random_device rseed;
+
+	return ( static_cast< uint64_t > ( rseed() ) << 32 ) | rseed();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include "RandomGenerator.h"
+
+#include "enums/RandomStream.h"
+
+// Holds one RandomGenerator per RandomStream, all seeded from a single seed
+// Seeding the service is all it takes to make a game ( or a replay, or a benchmark ) play out the same way again
+class RandomService
+{
+	public:
+	RandomService();
+	explicit RandomService( uint64_t seed_ );
+
+	void Seed( uint64_t seed_ );
+	uint64_t GetSeed() const;
+
+	RandomGenerator &GetGenerator( RandomStream stream );
+
+	// The service used by the calling thread. Every thread has its own unless SetCurrent has been called
+	static RandomService &Current();
+	static void SetCurrent( RandomService* service );
+
+	static RandomGenerator &Get( RandomStream stream )
+	{
+		return Current().GetGenerator( stream );
+	}
+
+	// A seed nobody can predict, for when the game isn't being replayed
+	static uint64_t GenerateSeed();
+
+	private:
+	uint64_t seed;
+	RandomGenerator generators[ static_cast< int > ( RandomStream::Count ) ];
+};
@@ -0,0 +1,53 @@
+#include "ViewTransform.h"
+
+#include "Rect.h"
+#include "Vector2f.h"
+
+#include <cmath>
+#include <algorithm>
+
+SDL_Rect ViewTransform::GetField()
+{
+	SDL_Rect field;
+	field.x = 0;
+	field.y = 0;
+	field.w = fieldWidth;
+	field.h = fieldHeight;
+	return field;
+}
+ViewTransform::ViewTransform()
+	:	scale( 1.0 )
+	,	offsetX( 0.0 )
+	,	offsetY( 0.0 )
+{
+}
+void ViewTransform::SetScreenSize( double width, double height )
+{
+	scale = std::min( width / fieldWidth, height / fieldHeight );
+	offsetX = ( width - ( fieldWidth * scale ) ) * 0.5;
+	offsetY = ( height - ( fieldHeight * scale ) ) * 0.5;
+}
+Vector2f ViewTransform::ToScreen( const Vector2f &field ) const
+{
+	return Vector2f( ( field.x * scale ) + offsetX, ( field.y * scale ) + offsetY );
+}
+SDL_Rect ViewTransform::ToScreen( const Rect &field ) const
+{
+	Vector2f topLeft = ToScreen( Vector2f( field.x, field.y ) );
+	Vector2f bottomRight = ToScreen( Vector2f( field.x + field.w, field.y + field.h ) );
+
+	SDL_Rect screen;
+	screen.x = static_cast< int > ( std::lround( topLeft.x ) );
+	screen.y = static_cast< int > ( std::lround( topLeft.y ) );
+	screen.w = static_cast< int > ( std::lround( bottomRight.x ) ) - screen.x;
+	screen.h = static_cast< int > ( std::lround( bottomRight.y ) ) - screen.y;
+	return screen;
+}
+Vector2f ViewTransform::ToField( const Vector2f &screen ) const
+{
+	return Vector2f( ( screen.x - offsetX ) / scale, ( screen.y - offsetY ) / scale );
+}
+double ViewTransform::GetScale() const
+{
+	return scale;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#include <SDL2/SDL.h>
+
+struct Rect;
+struct Vector2f;
+
+// Maps between the field and the screen
+//
+// The game is played on a field of 1920 x 1080 logical units on every screen, the resolution the boards are made for
+// Physics, boards and messages only ever see the field. Only the Renderer knows the screen, and the mouse is mapped back from it
+// The field is scaled to fit the screen and centered
+class ViewTransform
+{
+	public:
+		static const int32_t fieldWidth = 1920;
+		static const int32_t fieldHeight = 1080;
+
+		// The bounds of the field, what PhysicsManager and the boards call the window size
+		static SDL_Rect GetField();
+
+		ViewTransform();
+
+		// Only changes the transform, nothing in the field has to be touched
+		void SetScreenSize( double width, double height );
+
+		Vector2f ToScreen( const Vector2f &field ) const;
+		// The edges are rounded, not the size, so pieces that touch in the field still touch on the screen
+		SDL_Rect ToScreen( const Rect &field ) const;
+		Vector2f ToField( const Vector2f &screen ) const;
+
+		// Screen pixels per logical unit
+		double GetScale() const;
+
+	private:
+		double scale;
+		double offsetX;
+		double offsetY;
+};
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+
+#include "enums/BonusType.h"
+
 struct PlayerInfo
 {
 	PlayerInfo()
@@ -7,27 +11,26 @@ struct PlayerInfo
 		,	fireInterval( 1 )
 		,	fireInterval_Normal( 1 )
 		,	fireInterval_Slow( 2000 )
+		,	bonusActive()
 	{
-		bonusMap[BonusType::FireBullets] = false;
-		bonusMap[BonusType::SuperBall] = false;
 	}
 	void Reset()
 	{
 		points = 0;
 		lives = 3;
 		activeBalls = 0;
-		bonusMap[BonusType::FireBullets] = false;
-		bonusMap[BonusType::SuperBall] = false;
+		RemoveAllBonuses();
 	}
 
+	// Checked for every ball on every tile hit
 	bool IsBonusActive( BonusType bonusType ) const
 	{
-		return bonusMap.at( bonusType );
+		return bonusActive[ static_cast< size_t > ( bonusType ) ];
 	}
 
 	void SetBonusActive( BonusType bonusType, bool isActive )
 	{
-		 bonusMap[ bonusType ] = isActive;
+		 bonusActive[ static_cast< size_t > ( bonusType ) ] = isActive;
 
 		 if ( bonusType == BonusType::SuperBall )
 		 {
@@ -47,28 +50,28 @@ struct PlayerInfo
 	}
 	void RemoveAllBonuses()
 	{
-		for ( auto &p : bonusMap )
-			p.second = false;
+		bonusActive.fill( false );
 	}
 	bool CanSpawnNewBall()
 	{
 		return ( lives > 0 && activeBalls == 0 );
 	}
-	bool CanFireBullet()
+	// now is the game time, so that replays fire at the same time as the recorded game
+	bool CanFireBullet( uint32_t now )
 	{
 		if ( !IsBonusActive( BonusType::FireBullets ) )
 			return false;
 
-		bool canFire =  ( SDL_GetTicks() - lastBulletFired  ) > fireInterval;
+		bool canFire =  ( now - lastBulletFired  ) > fireInterval;
 
 		if ( canFire )
-			ResetBulletTimer();
+			ResetBulletTimer( now );
 
 		return canFire;
 	}
-	void ResetBulletTimer()
+	void ResetBulletTimer( uint32_t now )
 	{
-		lastBulletFired = SDL_GetTicks();
+		lastBulletFired = now;
 	}
 	std::string name;
 	uint32_t points;
@@ -78,7 +81,7 @@ struct PlayerInfo
 	uint32_t fireInterval;
 	uint32_t fireInterval_Normal;
 	uint32_t fireInterval_Slow; // Fire speed when SuperBall and not fast mode
-	std::map< BonusType, bool > bonusMap;
+	std::array< bool, static_cast< size_t > ( BonusType::Count ) > bonusActive;
 	double ballSpeed;
 	bool fastMode;
 };
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <map>
+#include <cstdint>
+
+#include "enums/TileType.h"
+#include "enums/ConfigValueType.h"
+
+// Everything needed to start a replay in the same state as the recorded game
+struct ReplayHeader
+{
+	ReplayHeader()
+		:	seed( 0 )
+		,	width( 0 )
+		,	height( 0 )
+		,	isAIControlled( false )
+		,	fastMode( false )
+		,	configValues()
+		,	points()
+	{
+	}
+	uint64_t seed;
+	int32_t width;
+	int32_t height;
+	bool isAIControlled;
+	bool fastMode;
+	std::map< ConfigValueType, double > configValues;
+	std::map< TileType, int32_t > points;
+};
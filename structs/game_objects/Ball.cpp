@@ -4,7 +4,7 @@
 
 #include <SDL2/SDL.h>
 
-#include "math/Math.h"
+#include "math/RandomService.h"
 #include "math/RectHelpers.h"
 #include "math/Vector2f.h"
 
@@ -13,6 +13,7 @@
 
 Ball::Ball( const SDL_Rect &windowSize, const Player &owner, int32_t ID   )
 	:	ballOwner( owner )
+	,	correction( 0.0, 0.0 )
 {
 	SetObjectID( ID );
 	rect.w = 20;
@@ -28,20 +29,22 @@ Ball::~Ball()
 }
 void Ball::Reset( const SDL_Rect &windowSize )
 {
-	SetSpeed(0.3f * RandomHelper::GenRandomNumber( 1 ));
+	RandomGenerator &random = RandomService::Get( RandomStream::Gameplay );
+
+	SetSpeed(0.3f * random.GenRandomNumber( 1 ));
 
 	// X pos and dirX is the same for both local and remote player
-	dir.x = RandomHelper::GenRandomNumber( -1.0, 1.0 );
+	dir.x = random.GenRandomNumber( -1.0, 1.0 );
 	rect.x = ( windowSize.w * 0.5 ) - ( rect.w * 0.5 );
 
 	if ( ballOwner == Player::Local )
 	{
-		dir.y = RandomHelper::GenRandomNumber( -0.9, -0.1 );
+		dir.y = random.GenRandomNumber( -0.9, -0.1 );
 		rect.y = windowSize.h - 75;
 	}
 	else if ( ballOwner == Player::Remote )
 	{
-		dir.y = RandomHelper::GenRandomNumber(  0.1, 0.9 );
+		dir.y = random.GenRandomNumber(  0.1, 0.9 );
 		rect.y = 150;
 	}
 
@@ -180,12 +183,17 @@ void Ball::HandlePaddleHit( const Rect &paddleRect )
 	CalculateNewBallDirection( hitPosition );
 
 	SetSpeed( GetSpeed() * 1.0005f);
-	MoveBallOutOfPaddle( paddleRect.y );
+	MoveBallOutOfPaddle( paddleRect );
 }
-void Ball::MoveBallOutOfPaddle( double paddleTop )
+void Ball::MoveBallOutOfPaddle( const Rect &paddleRect )
 {
-	double bottom = rect.y + rect.h;
-	double delta = bottom - paddleTop;
+	// Local balls hit the top of the bottom paddle, remote balls hit the bottom of the top paddle
+	double delta = 0.0;
+
+	if ( ballOwner == Player::Local )
+		delta = ( rect.y + rect.h ) - paddleRect.y;
+	else
+		delta = ( paddleRect.y + paddleRect.h ) - rect.y;
 
 	oldRect.x = rect.x;
 	oldRect.y = rect.y;
@@ -204,7 +212,11 @@ double Ball::CalculatePaddleHitPosition( const Rect &paddleRect ) const
 void  Ball::CalculateNewBallDirection( double hitPosition )
 {
 	dir.x = hitPosition;
-	dir.y = ( dir.y > 0.0f ) ? dir.y * -1.0f : dir.y;
+
+	if ( ballOwner == Player::Local )
+		dir.y = ( dir.y > 0.0f ) ? dir.y * -1.0f : dir.y;
+	else
+		dir.y = ( dir.y < 0.0f ) ? dir.y * -1.0f : dir.y;
 
 	NormalizeDirection();
 }
@@ -226,10 +238,10 @@ bool Ball::TileCheck( const Rect &tileRect, bool isSuperBall )
 	//if ( lastTileHit == tileID ) return false;
 	//lastTileHit = tileID;
 
-	if ( !isSuperBall )
-		FindIntersectingSide( tileRect );
-
-	return true;
+	if ( isSuperBall )
+		return TileCheck< true >( tileRect );
+	else
+		return TileCheck< false >( tileRect );
 }
 bool Ball::CheckTileSphereIntersection( const Rect &tile, const Rect &ball, double &retDistance ) const
 {
@@ -473,7 +485,71 @@ Player Ball::GetOwner( ) const
 {
 	return ballOwner;
 }
-void Ball::SetRemoteScale( double scale_ )
+void Ball::Extrapolate( double time, const SDL_Rect &boundsRect )
 {
-	SetSpeed( GetSpeed() * scale_ );
+	// Step through the time using the same movement and bounds checking as a regular update
+	// So that wall bounces that happened in transit are included
+	const double stepSize = 1.0 / 120.0;
+
+	while ( time > 0.0 )
+	{
+		double step = ( time < stepSize ) ? time : stepSize;
+
+		Update( step );
+		BoundCheck( boundsRect );
+
+		time -= step;
+	}
+}
+void Ball::Reconcile( const Vector2f &pos, const Vector2f &dir_, double age, const SDL_Rect &boundsRect )
+{
+	// Balls that are this far off are snapped into place, smoothing would just look like the ball is sliding
+	const double snapDistance = rect.w * 4.0;
+
+	Rect displayed = rect;
+	Rect displayedOld = oldRect;
+
+	// Predict where the ball is now from where it was when the message was sent
+	rect.x = pos.x;
+	rect.y = pos.y;
+	dir = dir_;
+
+	Extrapolate( age, boundsRect );
+
+	Vector2f error( rect.x - displayed.x, rect.y - displayed.y );
+
+	if ( sqrt( ( error.x * error.x ) + ( error.y * error.y ) ) > snapDistance )
+	{
+		oldRect.x = displayed.x;
+		oldRect.y = displayed.y;
+		correction = Vector2f( 0.0, 0.0 );
+		return;
+	}
+
+	// Keep showing the ball where it was and remove the error over the next few frames
+	rect = displayed;
+	oldRect = displayedOld;
+	correction = error;
+}
+void Ball::ApplyCorrection( double tick )
+{
+	// Time to remove most of the error between displayed and predicted position
+	const double correctionTime = 0.1;
+
+	if ( correction.x == 0.0 && correction.y == 0.0 )
+		return;
+
+	double amount = tick / correctionTime;
+	if ( amount > 1.0 )
+		amount = 1.0;
+
+	Vector2f move( correction.x * amount, correction.y * amount );
+
+	rect.x += move.x;
+	rect.y += move.y;
+	correction -= move;
+
+	// Stop once the remaining error is too small to be seen
+	if ( fabs( correction.x ) < 0.01 && fabs( correction.y ) < 0.01 )
+		correction = Vector2f( 0.0, 0.0 );
 }
@@ -23,6 +23,16 @@ struct Ball : GamePiece
 	bool DeathCheck( const SDL_Rect &boundsRect );
 	bool PaddleCheck( const Rect &paddleRect );
 	bool TileCheck( const Rect &tileRect, bool isSuperBall );
+	// For loops that know isSuperBall for every ball up front, so the check is compiled away
+	template < bool isSuperBall >
+	bool TileCheck( const Rect &tileRect )
+	{
+		// A super ball goes straight through
+		if ( !isSuperBall )
+			FindIntersectingSide( tileRect );
+
+		return true;
+	}
 	bool DidBallHitTile( const Rect &tileRect );
 
 	bool CheckTileSphereIntersection( const Rect &tile, const Rect &ball, double &retDistance ) const;
@@ -30,7 +40,11 @@ struct Ball : GamePiece
 	void SetOwner( Player owner );
 	Player GetOwner( ) const;
 
-	void SetRemoteScale( double scale_ );
+	// Prediction of remote balls
+	//==================================
+	void Extrapolate( double time, const SDL_Rect &boundsRect );
+	void Reconcile( const Vector2f &pos, const Vector2f &dir_, double age, const SDL_Rect &boundsRect );
+	void ApplyCorrection( double tick );
 
 	private:
 
@@ -46,7 +60,7 @@ struct Ball : GamePiece
 	void HandlePaddleHit( const Rect &paddleRect );
 	double CalculatePaddleHitPosition( const Rect &paddleRect ) const;
 	void CalculateNewBallDirection( double  hitPosition );
-	void MoveBallOutOfPaddle( double paddleEdge );
+	void MoveBallOutOfPaddle( const Rect &paddleRect );
 
 	// Find intersectin side
 	// ==================================
@@ -70,6 +84,9 @@ struct Ball : GamePiece
 
 	Player ballOwner;
 
+	// Remaining distance between the displayed and the predicted position of a remote ball
+	Vector2f correction;
+
 	//Ball( const Ball &other) = delete;
 	Ball( const Ball &other);
 	Ball& operator=( const Ball &other);
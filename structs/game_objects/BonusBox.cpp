@@ -22,5 +22,5 @@ Player BonusBox::GetOwner() const
 }
 void BonusBox::FlipXDir()
 {
-	direction.x *= -1.0;
+	dir.x *= -1.0;
 }
@@ -28,5 +28,4 @@ struct BonusBox : GamePiece
 	private:
 		Player owner;
 		BonusType bonusType;
-		Vector2f direction;
 };
@@ -50,7 +50,7 @@ bool Bullet::WillHitTile( const Rect &tileRect  )
 	double tileRight = tileLeft + tileRect.w;
 
 	double bulletLeft = rect.x;
-	double bulletRight = tileLeft + rect.w;
+	double bulletRight = bulletLeft + rect.w;
 
 	if ( bulletLeft > tileRight || bulletRight < tileLeft )
 		return false;
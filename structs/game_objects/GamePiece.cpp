@@ -1,4 +1,5 @@
 #include "GamePiece.h"
+#include "Graveyard.h"
 
 #include <SDL2/SDL.h>
 
@@ -9,9 +10,25 @@ GamePiece::GamePiece()
 	,	isAlive( true )
 	,	scale( 1.0 )
 	,	speed( 0.01 )
+	,	texture( nullptr )
+	,	graveyard( nullptr )
+	,	pieceType( PieceType::Ball )
 	{
 
 	}
+GamePiece::~GamePiece()
+{
+}
+void GamePiece::Kill()
+{
+	if ( !isAlive )
+		return;
+
+	isAlive = false;
+
+	if ( graveyard )
+		graveyard->Bury( shared_from_this(), pieceType );
+}
 void GamePiece::SetTexture( SDL_Texture* generatedTexture )
 {
 	texture = generatedTexture;
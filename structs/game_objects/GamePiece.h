@@ -1,16 +1,21 @@
 #pragma once
 
+#include <memory>
 #include <cstdint>
 
 #include "math/Rect.h"
 #include "math/Vector2f.h"
 
+#include "enums/PieceType.h"
 #include "enums/TextureType.h"
 
 struct SDL_Texture;
-struct GamePiece
+class Graveyard;
+
+struct GamePiece : std::enable_shared_from_this< GamePiece >
 {
 	GamePiece();
+	virtual ~GamePiece();
 
 	Rect rect;
 	Rect oldRect;
@@ -18,9 +23,12 @@ struct GamePiece
 
 	TextureType textureType;
 
-	void Kill()
+	// Puts the piece in its graveyard, if it has one, so it's removed at the end of the tick
+	virtual void Kill();
+	void SetGraveyard( Graveyard* graveyard_, PieceType pieceType_ )
 	{
-		isAlive = false;
+		graveyard = graveyard_;
+		pieceType = pieceType_;
 	}
 	bool IsAlive() const
 	{
@@ -99,4 +107,7 @@ struct GamePiece
 	double scale;
 	double speed;
 	SDL_Texture* texture;
+
+	Graveyard* graveyard;
+	PieceType pieceType;
 };
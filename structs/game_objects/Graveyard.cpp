@@ -0,0 +1,49 @@
+#include "Graveyard.h"
+
+#include "Ball.h"
+#include "Tile.h"
+#include "Bullet.h"
+#include "BonusBox.h"
+
+namespace
+{
+	template < class T >
+	void TakeAs( std::vector< std::shared_ptr< GamePiece > > &buried, std::vector< std::shared_ptr< T > > &dead )
+	{
+		for ( const auto &piece : buried )
+			dead.push_back( std::static_pointer_cast< T > ( piece ) );
+
+		buried.clear();
+	}
+}
+
+Graveyard::Graveyard()
+	:	buried()
+{
+}
+void Graveyard::Bury( const std::shared_ptr< GamePiece > &piece, PieceType type )
+{
+	buried[ static_cast< size_t > ( type ) ].push_back( piece );
+}
+bool Graveyard::IsEmpty() const
+{
+	for ( const auto &pieces : buried )
+	{
+		if ( !pieces.empty() )
+			return false;
+	}
+
+	return true;
+}
+bool Graveyard::Take( DeadPieces &dead )
+{
+	if ( IsEmpty() )
+		return false;
+
+	TakeAs( buried[ static_cast< size_t > ( PieceType::Ball ) ], dead.balls );
+	TakeAs( buried[ static_cast< size_t > ( PieceType::Tile ) ], dead.tiles );
+	TakeAs( buried[ static_cast< size_t > ( PieceType::Bullet ) ], dead.bullets );
+	TakeAs( buried[ static_cast< size_t > ( PieceType::BonusBox ) ], dead.bonusBoxes );
+
+	return true;
+}
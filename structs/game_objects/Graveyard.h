@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <memory>
+
+#include "enums/PieceType.h"
+
+struct Ball;
+struct Tile;
+struct Bullet;
+struct BonusBox;
+struct GamePiece;
+
+// Everything that was killed since the last time the dead pieces were taken, in the order it died
+struct DeadPieces
+{
+	DeadPieces()
+		:	balls()
+		,	tiles()
+		,	bullets()
+		,	bonusBoxes()
+	{
+	}
+	bool IsEmpty() const
+	{
+		return balls.empty() && tiles.empty() && bullets.empty() && bonusBoxes.empty();
+	}
+	void Clear()
+	{
+		balls.clear();
+		tiles.clear();
+		bullets.clear();
+		bonusBoxes.clear();
+	}
+
+	std::vector< std::shared_ptr< Ball > > balls;
+	std::vector< std::shared_ptr< Tile > > tiles;
+	std::vector< std::shared_ptr< Bullet > > bullets;
+	std::vector< std::shared_ptr< BonusBox > > bonusBoxes;
+};
+
+// Killed pieces wait in here until the end of the tick ( see GameManager::RemoveDeadPieces )
+//
+// A piece that has been given a graveyard puts itself in it when it's killed ( see GamePiece::Kill )
+// The dead pieces are then removed from every list at once, with one pass over each list that has lost something
+// A tick where nothing died costs nothing, instead of one scan of every list
+class Graveyard
+{
+	public:
+		Graveyard();
+
+		// Called by the piece, the first time it is killed
+		void Bury( const std::shared_ptr< GamePiece > &piece, PieceType type );
+
+		bool IsEmpty() const;
+
+		// Moves the dead pieces into dead. Returns false if nothing has died
+		bool Take( DeadPieces &dead );
+
+		// Removes every dead piece from list with swap-and-pop, so the order of the rest changes
+		template < class T >
+		static void Compact( std::vector< std::shared_ptr< T > > &list )
+		{
+			size_t i = 0;
+
+			while ( i < list.size() )
+			{
+				if ( list[i]->IsAlive() )
+				{
+					++i;
+					continue;
+				}
+
+				list[i] = std::move( list.back() );
+				list.pop_back();
+			}
+		}
+
+	private:
+		std::array< std::vector< std::shared_ptr< GamePiece > >, static_cast< size_t > ( PieceType::Count ) > buried;
+
+		Graveyard( const Graveyard &other );
+		Graveyard& operator=( const Graveyard &other );
+};
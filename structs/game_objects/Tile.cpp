@@ -1,4 +1,5 @@
 #include "Tile.h"
+#include "TileTracker.h"
 
 #include "math/Vector2f.h"
 #include "math/VectorHelpers.h"
@@ -9,6 +10,7 @@
 Tile::Tile(TileType type_, unsigned int tileID_ )
 	:	type( type_ )
 	,	hitsLeft( 1 )
+	,	tracker( nullptr )
 {
 	type = type_;
 	SetObjectID( tileID_ );
@@ -36,6 +38,13 @@ void Tile::Hit()
 	if ( hitsLeft == 0 && type != TileType::Unbreakable )
 		Kill();
 }
+void Tile::Kill()
+{
+	if ( IsAlive() && tracker )
+		tracker->TileKilled( type );
+
+	GamePiece::Kill();
+}
 bool Tile::CheckExplosion( const Rect &explodingTile )
 {
 	return explodingTile.x > 2.0;
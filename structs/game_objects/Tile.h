@@ -3,6 +3,8 @@
 #include "GamePiece.h"
 #include "enums/TileType.h"
 
+class TileTracker;
+
 struct Tile : GamePiece
 {
 	public:
@@ -28,10 +30,18 @@ struct Tile : GamePiece
 	bool CheckExplosion( const Rect &explodingTile );
 
 	void Hit();
+	// Tells the tracker, so the tile counts are right as soon as the tile dies
+	void Kill();
+
+	void SetTracker( TileTracker* tracker_ )
+	{
+		tracker = tracker_;
+	}
 
 	private:
 		TileType type;
 		unsigned short hitsLeft;
+		TileTracker* tracker;
 };
 inline bool operator==( const Tile &tile1, const Tile &tile2)
 {
@@ -0,0 +1,71 @@
+#include "TileColumns.h"
+
+#include <cmath>
+
+#include "Tile.h"
+
+TileColumns::TileColumns()
+	:	columnWidth( 60.0 )
+	,	columns()
+{
+}
+void TileColumns::Add( const std::shared_ptr< Tile > &tile )
+{
+	size_t first = ColumnOf( tile->rect.x );
+	size_t last = ColumnOf( tile->rect.x + tile->rect.w );
+	double bottom = tile->rect.y + tile->rect.h;
+
+	if ( last >= columns.size() )
+		columns.resize( last + 1 );
+
+	for ( size_t i = first; i <= last; ++i )
+	{
+		Column &column = columns[i];
+		auto it = std::upper_bound( column.begin(), column.end(), bottom, CompareBottom );
+
+		column.insert( it, { bottom, first, tile } );
+	}
+}
+void TileColumns::Remove( const std::shared_ptr< Tile > &tile )
+{
+	auto isTile = [ &tile ]( const Entry &entry )
+	{
+		return entry.tile == tile;
+	};
+
+	size_t first = ColumnOf( tile->rect.x );
+	size_t last = std::min( ColumnOf( tile->rect.x + tile->rect.w ), columns.size() - 1 );
+
+	for ( size_t i = first; i < columns.size() && i <= last; ++i )
+	{
+		Column &column = columns[i];
+		column.erase( std::remove_if( column.begin(), column.end(), isTile ), column.end() );
+	}
+}
+void TileColumns::Clear()
+{
+	columns.clear();
+}
+void TileColumns::Rebuild( const std::vector< std::shared_ptr< Tile > > &tiles, double columnWidth_ )
+{
+	columnWidth = columnWidth_;
+	columns.clear();
+
+	for ( const auto &tile : tiles )
+		Add( tile );
+}
+size_t TileColumns::GetColumnCount() const
+{
+	return columns.size();
+}
+bool TileColumns::CompareBottom( double bottom, const Entry &entry )
+{
+	return bottom < entry.bottom;
+}
+size_t TileColumns::ColumnOf( double x ) const
+{
+	if ( x <= 0.0 )
+		return 0;
+
+	return static_cast< size_t > ( std::floor( x / columnWidth ) );
+}
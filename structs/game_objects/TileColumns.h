@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+
+struct Tile;
+
+// The tiles split into columns of a fixed width, each column sorted by the bottom edge of its tiles
+//
+// Bullets only move straight up or down, so everything a bullet can hit is in the columns under it
+// Finding what's below a point is a binary search in each of those columns, and the tiles above it are never looked at
+// A tile that is wider than a column, or not lined up with them, is in every column it touches
+class TileColumns
+{
+	public:
+		TileColumns();
+
+		void Add( const std::shared_ptr< Tile > &tile );
+		void Remove( const std::shared_ptr< Tile > &tile );
+		void Clear();
+
+		// The tiles have moved or changed size, which happens when the board is scaled
+		void Rebuild( const std::vector< std::shared_ptr< Tile > > &tiles, double columnWidth_ );
+
+		// Calls function with every tile in the columns [ left, right ] touches, that has its bottom edge below top
+		// Every tile is only given once, even if it is in more than one of the columns
+		template < class Function >
+		void ForEachBelow( double left, double right, double top, Function function ) const
+		{
+			if ( columns.empty() )
+				return;
+
+			size_t first = ColumnOf( left );
+			size_t last = std::min( ColumnOf( right ), columns.size() - 1 );
+
+			for ( size_t i = first; i <= last; ++i )
+			{
+				const Column &column = columns[i];
+				auto it = std::upper_bound( column.begin(), column.end(), top, CompareBottom );
+
+				for ( ; it != column.end(); ++it )
+				{
+					// Already given in an earlier column
+					if ( i != std::max( first, it->firstColumn ) )
+						continue;
+
+					function( it->tile );
+				}
+			}
+		}
+
+		size_t GetColumnCount() const;
+
+	private:
+		struct Entry
+		{
+			double bottom;
+			size_t firstColumn;
+			std::shared_ptr< Tile > tile;
+		};
+		typedef std::vector< Entry > Column;
+
+		static bool CompareBottom( double bottom, const Entry &entry );
+
+		size_t ColumnOf( double x ) const;
+
+		double columnWidth;
+		std::vector< Column > columns;
+
+		TileColumns( const TileColumns &other );
+		TileColumns& operator=( const TileColumns &other );
+};
@@ -0,0 +1,47 @@
+#include "TileTracker.h"
+
+#include "Tile.h"
+
+TileTracker::TileTracker()
+	:	aliveCount()
+	,	totalAlive( 0 )
+{
+	aliveCount.fill( 0 );
+}
+void TileTracker::Add( const std::shared_ptr< Tile > &tile )
+{
+	tile->SetTracker( this );
+
+	if ( !tile->IsAlive() )
+		return;
+
+	++aliveCount[ tile->GetTileTypeAsIndex() ];
+	++totalAlive;
+}
+void TileTracker::Remove( const std::shared_ptr< Tile > &tile )
+{
+	tile->SetTracker( nullptr );
+
+	if ( !tile->IsAlive() )
+		return;
+
+	--aliveCount[ tile->GetTileTypeAsIndex() ];
+	--totalAlive;
+}
+void TileTracker::TileKilled( TileType type )
+{
+	--aliveCount[ static_cast< size_t > ( type ) ];
+	--totalAlive;
+}
+int32_t TileTracker::CountAlive( TileType type ) const
+{
+	return aliveCount[ static_cast< size_t > ( type ) ];
+}
+int32_t TileTracker::CountAlive() const
+{
+	return totalAlive;
+}
+int32_t TileTracker::CountDestroyable() const
+{
+	return totalAlive - CountAlive( TileType::Unbreakable );
+}
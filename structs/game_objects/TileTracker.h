@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <cstdint>
+
+#include "enums/TileType.h"
+
+struct Tile;
+
+// How many tiles of each type are still alive
+//
+// The tiles report their own death ( see Tile::Kill ), so checking if the level is done doesn't have to look at the tiles
+class TileTracker
+{
+	public:
+		TileTracker();
+
+		void Add( const std::shared_ptr< Tile > &tile );
+		void Remove( const std::shared_ptr< Tile > &tile );
+
+		// Called by the tile, the first time it is killed
+		void TileKilled( TileType type );
+
+		int32_t CountAlive( TileType type ) const;
+		int32_t CountAlive() const;
+		// Everything but the unbreakable tiles
+		int32_t CountDestroyable() const;
+
+	private:
+		static const size_t tileTypeCount = static_cast< size_t > ( TileType::Wall_Of_Death ) + 1;
+
+		std::array< int32_t, tileTypeCount > aliveCount;
+		int32_t totalAlive;
+
+		TileTracker( const TileTracker &other );
+		TileTracker& operator=( const TileTracker &other );
+};
@@ -12,18 +12,18 @@
 ConfigItem::~ConfigItem()
 {
 }
-void ConfigItem::SetValueTexture( SDL_Texture* texture )
+void ConfigItem::SetValueText( const std::string &text )
 {
-	valueTexture = texture;
+	valueText = text;
 }
 void ConfigItem::SetValueRect( SDL_Rect r )
 {
 	valueRect = r;
 	GeneratePlussMinus();
 }
-SDL_Texture* ConfigItem::GetValueTexture( ) const
+const std::string &ConfigItem::GetValueText( ) const
 {
-	return valueTexture;
+	return valueText;
 }
 SDL_Rect ConfigItem::GetValueRect( ) const
 {
@@ -12,11 +12,12 @@ struct ConfigItem : public MenuItem
     virtual ~ConfigItem();
 	ConfigItem() = delete;
 
-	void SetValueTexture( SDL_Texture* texture );
+	// Drawn from a GlyphAtlas, so a new value doesn't render any text
+	void SetValueText( const std::string &text );
 
 	void SetValueRect( SDL_Rect r );
 
-	SDL_Texture* GetValueTexture( ) const;
+	const std::string &GetValueText( ) const;
 
 	SDL_Rect GetValueRect( ) const;
 
@@ -75,7 +76,7 @@ struct ConfigItem : public MenuItem
 	uint32_t value;
 	bool boolValue;
 
-	SDL_Texture* valueTexture;
+	std::string valueText;
 
 	SDL_Rect valueRect;
 	SDL_Rect plussRect;
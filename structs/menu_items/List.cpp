@@ -21,7 +21,7 @@ void List::Init( SDL_Renderer* renderer, SDL_Rect mainRect_, const SDL_Color &ba
 	r.FromSDLRect( mainArea.rect );
 
 	mainArea.texture = RenderHelpers::InitSurface( r, backgroundColor, renderer );
-	SDL_SetTextureAlphaMod( mainArea.texture, 173 );
+	mainArea.textureAlpha = 173;
 
 	InitScrollBar();
 }
@@ -1,20 +1,28 @@
 #include "MenuItem.h"
 
+#include "tools/RenderTools.h"
+
 #include <iostream>
 
 MenuItem::MenuItem( std::string name)
 	:	itemName( name )
 	,	itemRect( {0,0,0,0} )
 	,	texture( nullptr )
+	,	selectedTexture( nullptr )
+	,	selectedWidth( 0 )
+	,	selectedHeight( 0 )
 	,	isSelected( false )
-	,	hasChanged( true )
 {
 }
 MenuItem::MenuItem( const MenuItem &item )
 	:	itemName( item.GetName() )
 	,	itemRect( item.GetRect() )
-	,	texture( item.GetTexture() )
+	,	texture( item.texture )
+	,	selectedTexture( item.selectedTexture )
+	,	selectedWidth( item.selectedWidth )
+	,	selectedHeight( item.selectedHeight )
 	,	backgroundColor( item.GetBackgroundColor() )
+	,	isSelected( item.IsSelected() )
 {
 }
 MenuItem::~MenuItem()
@@ -83,38 +91,42 @@ const SDL_Rect* MenuItem::GetRectPtr() const
 }
 void MenuItem::SetTexture( SDL_Texture* text )
 {
-	SDL_DestroyTexture( texture );
+	RenderHelpers::DestroyTexture( texture );
 	texture = text;
 }
+void MenuItem::SetSelectedTexture( SDL_Texture* text, int32_t width, int32_t height )
+{
+	RenderHelpers::DestroyTexture( selectedTexture );
+	selectedTexture = text;
+	selectedWidth = width;
+	selectedHeight = height;
+}
 SDL_Texture* MenuItem::GetTexture( ) const
 {
+	if ( isSelected && selectedTexture != nullptr )
+		return selectedTexture;
+
 	return texture;
 }
+SDL_Rect MenuItem::GetTextureRect( ) const
+{
+	if ( isSelected && selectedTexture != nullptr )
+		return { itemRect.x, itemRect.y, selectedWidth, selectedHeight };
+
+	return itemRect;
+}
 bool MenuItem::IsSelected() const
 {
 	return isSelected;
 }
 void MenuItem::SetSelcted( bool selected )
 {
-	if ( isSelected != selected )
-		hasChanged = true;
-
 	isSelected = selected;
 }
 bool MenuItem::HasValidTexture() const
 {
 	return texture != nullptr;
 }
-bool MenuItem::HasUnderlineChanged()
-{
-	if ( hasChanged )
-	{
-		hasChanged = false;
-		return true;
-	}
-	else
-		return false;
-}
 void MenuItem::SetName( std::string str )
 {
 	itemName = str;
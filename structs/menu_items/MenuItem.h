@@ -31,13 +31,17 @@ struct MenuItem
 	const SDL_Rect* GetRectPtr() const;
 
 	void SetTexture( SDL_Texture* text );
+	// Rendered once along with the normal texture, so that selecting the item never renders any text
+	void SetSelectedTexture( SDL_Texture* text, int32_t width, int32_t height );
+	// The texture for the current state
 	SDL_Texture* GetTexture( ) const;
+	// Where GetTexture() goes. The selected texture can have a different size, but the item keeps its rect
+	SDL_Rect GetTextureRect( ) const;
 
 	bool IsSelected() const;
 	void SetSelcted( bool selected );
 
 	bool HasValidTexture() const;
-	bool HasUnderlineChanged();
 
 	void SetName( std::string str );
 	std::string GetName( ) const;
@@ -55,9 +59,11 @@ struct MenuItem
 	std::string itemName;
 	SDL_Rect itemRect;
 	SDL_Texture* texture;
+	SDL_Texture* selectedTexture;
+	int32_t selectedWidth;
+	int32_t selectedHeight;
 	SDL_Color backgroundColor;
 
 	bool isSelected;
-	bool hasChanged;
 };
 
@@ -0,0 +1,26 @@
+#pragma once
+
+// Bad network conditions to simulate, set from Config.txt or the command line. All 0 means a perfect network
+struct NetworkConditions
+{
+	NetworkConditions()
+		:	latency( 0.0 )
+		,	jitter( 0.0 )
+		,	bandwidth( 0.0 )
+		,	reorderChance( 0.0 )
+		,	lossChance( 0.0 )
+		,	disconnectAfter( 0.0 )
+	{
+	}
+	bool IsActive() const
+	{
+		return latency > 0.0 || jitter > 0.0 || bandwidth > 0.0 || reorderChance > 0.0 || lossChance > 0.0 || disconnectAfter > 0.0;
+	}
+
+	double latency;			// Milliseconds added to every packet
+	double jitter;			// Up to this many milliseconds are added randomly on top of the latency
+	double bandwidth;		// Max kilobytes per second, 0 is unlimited
+	double reorderChance;	// Chance of holding a datagram back so later ones overtake it. TCP keeps its order
+	double lossChance;		// Chance of losing a datagram. TCP never loses data
+	double disconnectAfter;	// Seconds before the game connection is cut, 0 is never
+};
@@ -0,0 +1,129 @@
+#include "NetworkSimulator.h"
+
+#include "../../math/RandomService.h"
+
+#include <algorithm>
+
+NetworkSimulator::NetworkSimulator()
+	:	conditions()
+	,	queue()
+	,	lastStreamRelease( 0 )
+	,	bandwidthBudget( 0.0 )
+	,	lastBudgetUpdate( 0 )
+	,	lostCount( 0 )
+	,	reorderedCount( 0 )
+{
+}
+void NetworkSimulator::SetConditions( const NetworkConditions &conditions_ )
+{
+	conditions = conditions_;
+}
+bool NetworkSimulator::IsActive() const
+{
+	return conditions.IsActive();
+}
+bool NetworkSimulator::Queue( const char* data, size_t size, bool isStream, uint32_t now )
+{
+	if ( !isStream && conditions.lossChance > 0.0 && GenRandomNumber( 1.0 ) < conditions.lossChance )
+	{
+		++lostCount;
+		return false;
+	}
+
+	double delay = conditions.latency;
+
+	if ( conditions.jitter > 0.0 )
+		delay += GenRandomNumber( conditions.jitter );
+
+	if ( !isStream && conditions.reorderChance > 0.0 && GenRandomNumber( 1.0 ) < conditions.reorderChance )
+	{
+		// Hold it back long enough for the next few packets to get ahead of it
+		delay += std::max( 30.0, conditions.latency * 0.5 + conditions.jitter );
+		++reorderedCount;
+	}
+
+	Packet packet;
+	packet.releaseTime = now + static_cast< uint32_t > ( delay + 0.5 );
+	packet.data.assign( data, size );
+
+	// A stream can't deliver anything before what was sent ahead of it
+	if ( isStream )
+	{
+		if ( static_cast< int32_t > ( packet.releaseTime - lastStreamRelease ) < 0 )
+			packet.releaseTime = lastStreamRelease;
+
+		lastStreamRelease = packet.releaseTime;
+	}
+
+	// Sorted on release time, packets with the same time keep the order they were sent in
+	auto insertPos = std::upper_bound(
+		queue.begin(),
+		queue.end(),
+		packet.releaseTime,
+		[]( uint32_t time, const Packet &p ){ return static_cast< int32_t > ( time - p.releaseTime ) < 0; }
+	);
+
+	queue.insert( insertPos, std::move( packet ) );
+	return true;
+}
+bool NetworkSimulator::PopReady( uint32_t now, std::string &packet )
+{
+	UpdateBandwidthBudget( now );
+
+	if ( queue.empty() )
+		return false;
+
+	const Packet &next = queue.front();
+
+	if ( static_cast< int32_t > ( now - next.releaseTime ) < 0 )
+		return false;
+
+	if ( conditions.bandwidth > 0.0 )
+	{
+		double size = static_cast< double > ( next.data.size() );
+
+		// Packets larger than what can be sent in one go still have to get out eventually
+		double burst = conditions.bandwidth * 100.0;
+		if ( bandwidthBudget < std::min( size, burst ) )
+			return false;
+
+		bandwidthBudget -= size;
+	}
+
+	packet.swap( queue.front().data );
+	queue.pop_front();
+
+	return true;
+}
+void NetworkSimulator::UpdateBandwidthBudget( uint32_t now )
+{
+	if ( conditions.bandwidth <= 0.0 )
+		return;
+
+	// kilobytes per second is the same as bytes per millisecond
+	double elapsed = static_cast< double > ( now - lastBudgetUpdate );
+	lastBudgetUpdate = now;
+
+	// Don't allow more than 100 ms worth of data to be saved up
+	double burst = conditions.bandwidth * 100.0;
+	bandwidthBudget = std::min( bandwidthBudget + elapsed * conditions.bandwidth, burst );
+}
+void NetworkSimulator::Clear()
+{
+	queue.clear();
+	lastStreamRelease = 0;
+	bandwidthBudget = 0.0;
+}
+uint64_t NetworkSimulator::GetLostCount() const
+{
+	return lostCount;
+}
+uint64_t NetworkSimulator::GetReorderedCount() const
+{
+	return reorderedCount;
+}
+double NetworkSimulator::GenRandomNumber( double max )
+{
+	// Has its own stream, so simulating the network doesn't change the random numbers the game gets
+	return RandomService::Get( RandomStream::Network ).GenRandomNumber( 0.0, max );
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "NetworkConditions.h"
+
+// Holds outgoing packets back to make a local connection behave like a bad one
+// Used by TCPConnection and UDPConnection when any of the NetworkConditions are set
+class NetworkSimulator
+{
+	public:
+		NetworkSimulator();
+
+		void SetConditions( const NetworkConditions &conditions_ );
+		bool IsActive() const;
+
+		// isStream keeps the packets in order and never drops them, like TCP. Returns false if the packet was lost
+		bool Queue( const char* data, size_t size, bool isStream, uint32_t now );
+
+		// Gets the next packet that is due and fits within the bandwidth. Returns false if there is none
+		bool PopReady( uint32_t now, std::string &packet );
+
+		void Clear();
+
+		uint64_t GetLostCount() const;
+		uint64_t GetReorderedCount() const;
+
+	private:
+		struct Packet
+		{
+			uint32_t releaseTime;
+			std::string data;
+		};
+
+		void UpdateBandwidthBudget( uint32_t now );
+		double GenRandomNumber( double max );
+
+		NetworkConditions conditions;
+		std::deque< Packet > queue;
+
+		uint32_t lastStreamRelease;
+
+		double bandwidthBudget;
+		uint32_t lastBudgetUpdate;
+
+		uint64_t lostCount;
+		uint64_t reorderedCount;
+};
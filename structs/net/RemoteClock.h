@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+// Keeps track of the difference between the local clock and the clock of the oponent
+// The difference is measured with Ping / Pong messages, and is used to find out how old a timestamped message is
+struct RemoteClock
+{
+	RemoteClock()
+		:	offset( 0.0 )
+		,	roundTrip( 0.0 )
+		,	hasSample( false )
+	{
+	}
+	void Reset()
+	{
+		offset = 0.0;
+		roundTrip = 0.0;
+		hasSample = false;
+	}
+	// pingSent and now are local ticks, remoteTicks is the ticks of the oponent when the Ping was answered
+	void AddSample( uint32_t pingSent, uint32_t remoteTicks, uint32_t now )
+	{
+		double sampleRoundTrip = static_cast< double > ( now - pingSent );
+
+		// The Pong was sent roughly halfway through the round trip
+		double sampleOffset = static_cast< double > ( remoteTicks ) + ( sampleRoundTrip * 0.5 ) - static_cast< double > ( now );
+
+		if ( !hasSample )
+		{
+			offset = sampleOffset;
+			roundTrip = sampleRoundTrip;
+			hasSample = true;
+			return;
+		}
+
+		// Samples with a short round trip have had the least queuing, so they are trusted more
+		double weight = ( sampleRoundTrip <= roundTrip ) ? 0.5 : 0.1;
+
+		offset += ( sampleOffset - offset ) * weight;
+		roundTrip += ( sampleRoundTrip - roundTrip ) * 0.1;
+	}
+	// Returns how many seconds ago the oponent sent a message with the given timestamp
+	double GetAge( uint32_t remoteTimeStamp, uint32_t now ) const
+	{
+		if ( !hasSample )
+			return 0.0;
+
+		double age = ( static_cast< double > ( now ) + offset - static_cast< double > ( remoteTimeStamp ) ) / 1000.0;
+
+		// Don't extrapolate further than the ball can travel in a short while
+		if ( age < 0.0 )
+			return 0.0;
+
+		if ( age > maxAge )
+			return maxAge;
+
+		return age;
+	}
+	double GetRoundTrip() const
+	{
+		return roundTrip;
+	}
+
+	static constexpr double maxAge = 0.5;
+
+	private:
+	double offset;
+	double roundTrip;
+	bool hasSample;
+};
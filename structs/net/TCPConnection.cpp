@@ -1,13 +1,22 @@
 #include "TCPConnection.h"
 
+#include "TCPMessageParser.h"
+
 #include "../../Logger.h"
 
 #include <csignal>
+#include <algorithm>
 #include <iostream>
 
 TCPConnection::TCPConnection()
 	:	isConnected( false )
 	,   bufferSize( 80000 )
+	,	receiveBuffer( static_cast< size_t > ( bufferSize ) )
+	,	receivedSize( 0 )
+	,	outgoing()
+	,	bytesQueued( 0 )
+	,	bytesFlushed( 0 )
+	,	flushCount( 0 )
 {
 	logger = Logger::Instance();
 }
@@ -18,6 +27,8 @@ bool TCPConnection::Init( const std::string &host, unsigned short port, bool ser
 	isServer = server;
 	hostName = host;
 	portNr = port;
+	receivedSize = 0;
+	outgoing.clear();
 	socketSet = SDLNet_AllocSocketSet( 1 );
 
 	if ( !ResolveHost() )
@@ -93,29 +104,75 @@ bool TCPConnection::OpenConnectionToHost( )
 	return true;
 }
 
-void TCPConnection::Send( std::string str )
+void TCPConnection::Send( const char* data, size_t size )
 {
-	if ( !isConnected  )
+	if ( !isConnected || size == 0 )
 		return;
 
-	void* messageData = ConvertStringToVoidPtr(str);
-	int messageSize = static_cast< int > ( str.length() );
-	int bytesSent = 0;
+	if ( simulator.IsActive() )
+	{
+		simulator.Queue( data, size, true, SDL_GetTicks() );
+		return;
+	}
 
-	if ( isServer )
+	QueueBytes( data, size );
+}
+void TCPConnection::Send( const std::string &str )
+{
+	Send( str.data(), str.size() );
+}
+void TCPConnection::Flush()
+{
+	uint32_t now = SDL_GetTicks();
+
+	while ( isConnected && simulator.PopReady( now, simulatedPacket ) )
+		QueueBytes( simulatedPacket.data(), simulatedPacket.size() );
+
+	// The rest can't be sent on this connection anyway
+	if ( !SendQueue() )
 	{
-		bytesSent = SDLNet_TCP_Send( serverSocket,  messageData,  messageSize);
+		outgoing.clear();
+		Close();
 	}
+}
+void TCPConnection::SetNetworkConditions( const NetworkConditions &conditions )
+{
+	simulator.SetConditions( conditions );
+}
+void TCPConnection::QueueBytes( const char* data, size_t size )
+{
+	outgoing.insert( outgoing.end(), data, data + size );
+	bytesQueued += size;
+}
+bool TCPConnection::SendQueue()
+{
+	if ( !isConnected || outgoing.empty() )
+		return true;
+
+	int messageSize = static_cast< int > ( outgoing.size() );
+	int bytesSent = 0;
+
+	// SDL_net sockets are blocking, SDLNet_TCP_Send keeps writing until everything is sent or the connection fails
+	if ( isServer )
+		bytesSent = SDLNet_TCP_Send( serverSocket, &outgoing[ 0 ], messageSize );
 	else
+		bytesSent = SDLNet_TCP_Send( tcpSocket, &outgoing[ 0 ], messageSize );
+
+	if ( bytesSent > 0 )
 	{
-		bytesSent = SDLNet_TCP_Send( tcpSocket,  messageData,  messageSize);
+		outgoing.erase( outgoing.begin(), outgoing.begin() + bytesSent );
+		bytesFlushed += static_cast< uint64_t > ( bytesSent );
+		++flushCount;
 	}
 
 	if ( bytesSent < messageSize )
 	{
 		logger->Log( __FILE__, __LINE__, "Send failed : ", SDLNet_GetError() );
-		Close();
+		logger->Log( __FILE__, __LINE__, "Bytes not sent : ", outgoing.size() );
+		return false;
 	}
+
+	return true;
 }
 void TCPConnection::Close()
 {
@@ -126,6 +183,13 @@ void TCPConnection::Close()
 		return;
 	}
 
+	// Messages sent right before closing, like ending the game, still have to go out
+	SendQueue();
+
+	std::stringstream ss("");
+	ss << bytesFlushed << " of " << bytesQueued << " bytes in " << flushCount << " sends";
+	logger->Log( __FILE__, __LINE__, "Sent : ", ss.str() );
+
 	if ( isServer )
 	{
 		SDLNet_TCP_DelSocket( socketSet, serverSocket );
@@ -137,6 +201,8 @@ void TCPConnection::Close()
 		SDLNet_TCP_Close( tcpSocket );
 	}
 
+	simulator.Clear();
+	outgoing.clear();
 	isConnected = false;
 }
 void TCPConnection::Update()
@@ -206,36 +272,34 @@ bool TCPConnection::SetServerSocket()
 	isConnected = true;
 	return true;
 }
-std::string TCPConnection::ReadMessages()
+bool TCPConnection::ReadMessages( TCPMessageParser &parser )
 {
 	if ( !CheckForActivity() )
-		return "";
+		return false;
 
-	char buffer[bufferSize ];
-	memset( buffer, 0, bufferSize );
+	if ( receivedSize >= receiveBuffer.size() )
+	{
+		logger->Log( __FILE__, __LINE__, " Recieve buffer is full, dropping : ", receivedSize );
+		logger->Log( __FILE__, __LINE__, " ...Buffer size is : ", bufferSize );
+		receivedSize = 0;
+	}
 
+	// Anything left from the previous read is at the start of the buffer, new data goes after it
+	char* writePos = &receiveBuffer[ receivedSize ];
+	int freeSpace = static_cast< int > ( receiveBuffer.size() - receivedSize );
 	int byteCount  = 0;
-	std::string received("");
-
-	if ( !isConnected )
-		return received;
 
 	if ( isServer )
-		byteCount = SDLNet_TCP_Recv( serverSocket, buffer, bufferSize );
+		byteCount = SDLNet_TCP_Recv( serverSocket, writePos, freeSpace );
 	else
-		byteCount = SDLNet_TCP_Recv( tcpSocket, buffer, bufferSize );
+		byteCount = SDLNet_TCP_Recv( tcpSocket, writePos, freeSpace );
 
 	if ( byteCount > 0 )
 	{
-		//memset( &buffer[byteCount], 0, static_cast< size_t > (512 - byteCount ) );
-		buffer[byteCount] = '\0';
-		received = buffer;
+		receivedSize += static_cast< size_t > ( byteCount );
+		parser.SetBuffer( &receiveBuffer[ 0 ], receivedSize );
 
-		if ( byteCount >= bufferSize )
-		{
-			logger->Log( __FILE__, __LINE__, " Too much data reciebed : ", byteCount );
-			logger->Log( __FILE__, __LINE__, " ...Buffer size is : ", bufferSize );
-		}
+		return true;
 	}
 	// A bytecount of 0 means the connection has been terminated
 	else if ( byteCount == 0 )
@@ -249,7 +313,14 @@ std::string TCPConnection::ReadMessages()
 		logger->Log( __FILE__, __LINE__, "Read Failed : ", SDLNet_GetError() );
 	}
 
-	return received;
+	return false;
+}
+void TCPConnection::ConsumeMessages( const TCPMessageParser &parser )
+{
+	size_t consumed = std::min( parser.GetConsumed(), receivedSize );
+
+	std::copy( receiveBuffer.begin() + static_cast< std::ptrdiff_t > ( consumed ), receiveBuffer.begin() + static_cast< std::ptrdiff_t > ( receivedSize ), receiveBuffer.begin() );
+	receivedSize -= consumed;
 }
 bool TCPConnection::CheckForActivity() const
 {
@@ -273,10 +344,15 @@ bool TCPConnection::IsConnected() const
 {
 	return isConnected;
 }
-
-void* TCPConnection::ConvertStringToVoidPtr( const std::string &str )
+uint32_t TCPConnection::GetRemoteHost() const
 {
-	const char* charPtr = str.c_str();
+	if ( !isServer )
+		return ipAddress.host;
+
+	IPaddress* ipRemote = SDLNet_TCP_GetPeerAddress( serverSocket );
+
+	if ( ipRemote == nullptr )
+		return 0;
 
-	return const_cast< char* > ( charPtr );
+	return ipRemote->host;
 }
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <SDL2/SDL_net.h>
 
+#include "NetworkSimulator.h"
+
 class Logger;
+class TCPMessageParser;
 class TCPConnection
 {
 public:
@@ -15,10 +19,24 @@ public:
 	bool OpenConnectionToHost( );
 
 	bool CheckForActivity() const;
-	void Send( std::string str );
-	std::string ReadMessages();
+
+	// Copies the data into the outgoing queue, nothing is sent before Flush()
+	void Send( const char* data, size_t size );
+	void Send( const std::string &str );
+	// Sends everything in the outgoing queue, including what the network simulator has held back long enough
+	// All messages queued since the last flush go out in a single send
+	void Flush();
+
+	void SetNetworkConditions( const NetworkConditions &conditions );
+
+	// Recieves into the connection buffer and points the parser to it. Returns false if nothing new was recieved
+	bool ReadMessages( TCPMessageParser &parser );
+	// Removes the messages the parser is done with. Any cut off message is kept until the rest of it arrives
+	void ConsumeMessages( const TCPMessageParser &parser );
 
 	bool IsConnected() const;
+	// Address of the other end of the connection, in network byte order
+	uint32_t GetRemoteHost() const;
 
 	void Close();
 
@@ -27,7 +45,9 @@ public:
 	bool AcceptConnection();
 	bool SetServerSocket();
 private:
-	void* ConvertStringToVoidPtr( const std::string &str );
+	void QueueBytes( const char* data, size_t size );
+	// Returns false if the connection failed, whatever wasn't sent is left in the queue
+	bool SendQueue();
 
 	bool isServer;
 	std::string hostName;
@@ -36,6 +56,18 @@ private:
 	IPaddress ipAddress;
 	const int bufferSize;
 
+	std::vector< char > receiveBuffer;
+	size_t receivedSize;
+
+	NetworkSimulator simulator;
+	std::string simulatedPacket;
+
+	std::vector< char > outgoing;
+	// Logged when the connection is closed
+	uint64_t bytesQueued;
+	uint64_t bytesFlushed;
+	uint64_t flushCount;
+
 	TCPsocket tcpSocket;
 	TCPsocket serverSocket;
 	SDLNet_SocketSet socketSet;
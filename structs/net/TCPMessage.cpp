@@ -3,6 +3,8 @@
 TCPMessage::TCPMessage()
 	:	msgType( MessageType::PaddlePosition )
 	,	objectID( 0 )
+	,	timeStamp( 0 )
+	,	echoTimeStamp( 0 )
 {}
 std::string TCPMessage::Print() const
 {
@@ -48,6 +50,17 @@ std::string TCPMessage::Print() const
 		case BulletFire:
 			ss << " : " << pos1 << " Object 2 ID : " << objectID2 << " Pos : " << pos2;
 			break;
+		case BallSpawned:
+		case BallData:
+			ss << " : "  << pos1  << " , " <<  dir << " Time stamp : " << timeStamp;
+			break;
+		case Ping:
+		case Pong:
+			ss << " : " << timeStamp << " , " << echoTimeStamp;
+			break;
+		case UDPHandshake:
+			ss << " : " << port;
+			break;
 		default:
 			ss << " : "  << pos1  << " , " <<  dir;
 			break;
@@ -94,6 +107,12 @@ std::string TCPMessage::GetTypeAsString() const
 			return "Level Done";
 		case LastTileSent:
 			return "Last Tile Sent";
+		case Ping:
+			return "Ping";
+		case Pong:
+			return "Pong";
+		case UDPHandshake:
+			return "UDP Handshake";
 		default:
 			return "Unknown";
 	}
@@ -206,11 +225,11 @@ Vector2f TCPMessage::GetDir_YFlipped() const
 {
 	return Vector2f( dir.x, dir.y * -1.0 );
 }
-Vector2f TCPMessage::GetPos1() const
+LogicalPosition TCPMessage::GetPos1() const
 {
 	return pos1;
 }
-Vector2f TCPMessage::GetPos2() const
+LogicalPosition TCPMessage::GetPos2() const
 {
 	return pos2;
 }
@@ -218,6 +237,14 @@ Vector2f TCPMessage::GetSize() const
 {
 	return size;
 }
+uint32_t TCPMessage::GetTimeStamp() const
+{
+	return timeStamp;
+}
+uint32_t TCPMessage::GetEchoTimeStamp() const
+{
+	return echoTimeStamp;
+}
 uint16_t TCPMessage::GetPort() const
 {
 	return port;
@@ -267,23 +294,31 @@ void TCPMessage::SetBoardScale( double boardScale_)
 {
 	boardScale = boardScale_;
 }
+void TCPMessage::SetTimeStamp( uint32_t timeStamp_ )
+{
+	timeStamp = timeStamp_;
+}
+void TCPMessage::SetEchoTimeStamp( uint32_t echoTimeStamp_ )
+{
+	echoTimeStamp = echoTimeStamp_;
+}
 void TCPMessage::SetPort( uint16_t port_ )
 {
 	port = port_;
 }
-void TCPMessage::SetIPAdress( std::string  ipAddress_ )
+void TCPMessage::SetIPAdress( const std::string &ipAddress_ )
 {
 	ipAddress = ipAddress_;
 }
-void TCPMessage::SetPlayerName( std::string playerName_ )
+void TCPMessage::SetPlayerName( const std::string &playerName_ )
 {
 	playerName = playerName_;
 }
-void TCPMessage::SetPos1( Vector2f pos )
+void TCPMessage::SetPos1( LogicalPosition pos )
 {
 	pos1 = pos;
 }
-void TCPMessage::SetPos2( Vector2f pos )
+void TCPMessage::SetPos2( LogicalPosition pos )
 {
 	pos2 = pos;
 }
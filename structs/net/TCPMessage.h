@@ -11,6 +11,7 @@
 #include "../../enums/TileType.h"
 
 #include "../../math/Vector2f.h"
+#include "../../math/LogicalPosition.h"
 
 class TCPMessage
 {
@@ -40,10 +41,14 @@ class TCPMessage
 
 		Vector2f GetDir() const;
 		Vector2f GetDir_YFlipped() const;
-		Vector2f GetPos1() const;
-		Vector2f GetPos2() const;
+		// Positions are in the logical field, see ViewTransform
+		LogicalPosition GetPos1() const;
+		LogicalPosition GetPos2() const;
 		Vector2f GetSize() const;
 
+		uint32_t GetTimeStamp() const;
+		uint32_t GetEchoTimeStamp() const;
+
 		uint16_t GetPort() const;
 		std::string GetIPAdress() const;
 		std::string GetPlayerName() const;
@@ -65,18 +70,21 @@ class TCPMessage
 
 		void SetBoardScale( double boardScale_);
 
+		void SetTimeStamp( uint32_t timeStamp_ );
+		void SetEchoTimeStamp( uint32_t echoTimeStamp_ );
+
 		void SetPort( uint16_t port_ );
-		void SetIPAdress( std::string  ipAddress_ );
+		void SetIPAdress( const std::string &ipAddress_ );
 
-		void SetPlayerName( std::string playerName_ );
+		void SetPlayerName( const std::string &playerName_ );
 
-		void SetPos1( Vector2f pos );
-		void SetPos2( Vector2f pos );
+		void SetPos1( LogicalPosition pos );
+		void SetPos2( LogicalPosition pos );
 
 		void SetDir( Vector2f dir_ );
 		void SetSize( Vector2f size_ );
 
-		void SetLevelName( std::string levelName_ )
+		void SetLevelName( const std::string &levelName_ )
 		{
 			levelName = levelName_;
 		}
@@ -99,11 +107,15 @@ class TCPMessage
 
 		Vector2f size;
 
-		Vector2f pos1;
-		Vector2f pos2;
+		LogicalPosition pos1;
+		LogicalPosition pos2;
 
 		double boardScale;
 
+		// Sender ticks, used to age ball data and measure round trip time
+		uint32_t timeStamp;
+		uint32_t echoTimeStamp;
+
 		std::string ipAddress;
 		uint16_t port;
 
@@ -160,28 +172,31 @@ inline std::istream& operator>>( std::istream &is, TCPMessage &msg )
 		// Paddle position only has xPos
 		case PaddlePosition:
 			{
-				double pos = 0.0;
+				int32_t pos = 0;
 
 				is >> pos;
 
-				msg.SetPos1( Vector2f( pos, 0.0 ) );
+				msg.SetPos1( LogicalPosition( pos, 0 ) );
 				return is;
 			}
 		// BallData has both pos and dir
 		case BallSpawned:
+		case BallData:
 			{
-				Vector2f pos_;
+				LogicalPosition pos_;
 				Vector2f dir_;
+				uint32_t timeStamp_ = 0;
 
-				is >> pos_ >> dir_;
+				is >> pos_ >> dir_ >> timeStamp_;
 
 				msg.SetPos1( pos_ );
 				msg.SetDir( dir_ );
+				msg.SetTimeStamp( timeStamp_ );
 				return is;
 			}
 		case TileSpawned:
 			{
-				Vector2f pos_;
+				LogicalPosition pos_;
 				int32_t tileType_ = 0;
 
 				is >> tileType_  >> pos_;
@@ -190,11 +205,10 @@ inline std::istream& operator>>( std::istream &is, TCPMessage &msg )
 				msg.SetTileType( static_cast< TileType > ( tileType_ ) );
 				return is;
 			}
-		case BallData:
 		case BonusSpawned:
 			{
 				int bonusType;
-				Vector2f pos;
+				LogicalPosition pos;
 				Vector2f dir;
 
 				is >> bonusType >> pos >> dir;
@@ -208,8 +222,8 @@ inline std::istream& operator>>( std::istream &is, TCPMessage &msg )
 		case BulletFire:
 			{
 				int32_t objectID2 = 0;
-				Vector2f pos_;
-				Vector2f pos2_;
+				LogicalPosition pos_;
+				LogicalPosition pos2_;
 
 				is >> pos_ >> objectID2  >> pos2_;
 
@@ -268,6 +282,32 @@ inline std::istream& operator>>( std::istream &is, TCPMessage &msg )
 
 			return is;
 		}
+		case Ping:
+		{
+			uint32_t timeStamp_ = 0;
+			is >> timeStamp_;
+			msg.SetTimeStamp( timeStamp_ );
+
+			return is;
+		}
+		case Pong:
+		{
+			uint32_t timeStamp_ = 0;
+			uint32_t echoTimeStamp_ = 0;
+			is >> timeStamp_ >> echoTimeStamp_;
+			msg.SetTimeStamp( timeStamp_ );
+			msg.SetEchoTimeStamp( echoTimeStamp_ );
+
+			return is;
+		}
+		case UDPHandshake:
+		{
+			uint16_t port = 0;
+			is >> port;
+			msg.SetPort( port );
+
+			return is;
+		}
 		default:
 			{
 				std::cout << "Wrong message type : " << type << std::endl;
@@ -313,10 +353,12 @@ inline std::ostream& operator<<( std::ostream &os, const TCPMessage &message )
 			break;
 		// BallData has both pos and dir
 		case BallSpawned:
+		case BallData:
 			{
 			os
 				<< message.GetPos1() << " "
-				<< message.GetDir() << " ";
+				<< message.GetDir() << " "
+				<< message.GetTimeStamp() << " ";
 
 			break;
 			}
@@ -331,7 +373,6 @@ inline std::ostream& operator<<( std::ostream &os, const TCPMessage &message )
 			os << message.GetLevelName() << " ";
 			break;
 		}
-		case BallData:
 		case BonusSpawned:
 			os
 				<< message.GetBonusTypeAsInt()  << " "
@@ -363,6 +404,19 @@ inline std::ostream& operator<<( std::ostream &os, const TCPMessage &message )
 			os
 				<< message.GetPlayerName() << " ";
 			break;
+		case Ping:
+			os
+				<< message.GetTimeStamp() << " ";
+			break;
+		case Pong:
+			os
+				<< message.GetTimeStamp() << " "
+				<< message.GetEchoTimeStamp() << " ";
+			break;
+		case UDPHandshake:
+			os
+				<< message.GetPort() << " ";
+			break;
 		default:
 			std::cout << "Wrong message type : " << type << std::endl;
 			std::cin.ignore();
@@ -0,0 +1,335 @@
+#include "TCPMessageParser.h"
+
+#include "TCPMessage.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+
+TCPMessageParser::TCPMessageParser()
+	:	data( nullptr )
+	,	length( 0 )
+	,	position( 0 )
+	,	consumed( 0 )
+	,	stringBuffer()
+{
+}
+void TCPMessageParser::SetBuffer( const char* data_, size_t length_ )
+{
+	data = data_;
+	length = length_;
+	position = 0;
+	consumed = 0;
+}
+bool TCPMessageParser::ParseNext( TCPMessage &msg )
+{
+	// Start right after the last complete message
+	position = consumed;
+
+	int32_t type = 0;
+	uint32_t objectID = 0;
+
+	if ( !ReadInt( type ) || !ReadUInt( objectID ) )
+		return false;
+
+	msg.SetMessageType( type );
+	msg.SetObjectID( objectID );
+
+	if ( !ParseBody( type, msg ) )
+		return false;
+
+	consumed = position;
+	return true;
+}
+size_t TCPMessageParser::GetConsumed() const
+{
+	return consumed;
+}
+bool TCPMessageParser::ParseBody( int32_t type, TCPMessage &msg )
+{
+	// Has to match operator<<( std::ostream&, const TCPMessage& )
+	switch ( type )
+	{
+		// BallKilled and Tile Hit only needs message type and ID
+		case LevelDone:
+		case GameJoined:
+		case BallKilled:
+		case BonusPickup:
+		case GetGameList:
+		case BulletKilled:
+		case LastTileSent:
+		case BallRespawn:
+			return true;
+		case TileHit:
+			{
+				int32_t killed = 0;
+
+				if ( !ReadInt( killed ) )
+					return false;
+
+				msg.SetTileKilled( killed != 0 );
+				return true;
+			}
+		case GameSettings:
+			{
+				Vector2f size;
+				double boardScale = 0.0;
+
+				if ( !ReadVector2f( size ) || !ReadDouble( boardScale ) )
+					return false;
+
+				msg.SetSize( size );
+				msg.SetBoardScale( boardScale );
+				return true;
+			}
+		case PaddlePosition:
+			{
+				int32_t pos = 0;
+
+				if ( !ReadInt( pos ) )
+					return false;
+
+				msg.SetPos1( LogicalPosition( pos, 0 ) );
+				return true;
+			}
+		case BallSpawned:
+		case BallData:
+			{
+				LogicalPosition pos;
+				Vector2f dir;
+				uint32_t timeStamp = 0;
+
+				if ( !ReadLogicalPosition( pos ) || !ReadVector2f( dir ) || !ReadUInt( timeStamp ) )
+					return false;
+
+				msg.SetPos1( pos );
+				msg.SetDir( dir );
+				msg.SetTimeStamp( timeStamp );
+				return true;
+			}
+		case TileSpawned:
+			{
+				int32_t tileType = 0;
+				LogicalPosition pos;
+
+				if ( !ReadInt( tileType ) || !ReadLogicalPosition( pos ) )
+					return false;
+
+				msg.SetPos1( pos );
+				msg.SetTileType( static_cast< TileType > ( tileType ) );
+				return true;
+			}
+		case BonusSpawned:
+			{
+				int32_t bonusType = 0;
+				LogicalPosition pos;
+				Vector2f dir;
+
+				if ( !ReadInt( bonusType ) || !ReadLogicalPosition( pos ) || !ReadVector2f( dir ) )
+					return false;
+
+				msg.SetBonusType( bonusType );
+				msg.SetPos1( pos );
+				msg.SetDir( dir );
+				return true;
+			}
+		case BulletFire:
+			{
+				LogicalPosition pos;
+				uint32_t objectID2 = 0;
+				LogicalPosition pos2;
+
+				if ( !ReadLogicalPosition( pos ) || !ReadUInt( objectID2 ) || !ReadLogicalPosition( pos2 ) )
+					return false;
+
+				msg.SetObjectID2( objectID2 );
+				msg.SetPos1( pos );
+				msg.SetPos2( pos2 );
+				return true;
+			}
+		case GameStateChanged:
+			{
+				int32_t gameState = 0;
+
+				if ( !ReadInt( gameState ) )
+					return false;
+
+				msg.SetGameState( gameState );
+				return true;
+			}
+		case EndGame:
+			{
+				uint32_t port = 0;
+
+				if ( !ReadString( stringBuffer ) || !ReadUInt( port ) )
+					return false;
+
+				msg.SetIPAdress( stringBuffer );
+				msg.SetPort( static_cast< uint16_t > ( port ) );
+				return true;
+			}
+		case NewGame:
+			{
+				uint32_t port = 0;
+
+				if ( !ReadString( stringBuffer ) || !ReadUInt( port ) )
+					return false;
+
+				msg.SetIPAdress( stringBuffer );
+				msg.SetPort( static_cast< uint16_t > ( port ) );
+
+				if ( !ReadString( stringBuffer ) )
+					return false;
+
+				msg.SetPlayerName( stringBuffer );
+				return true;
+			}
+		case PlayerName:
+			{
+				if ( !ReadString( stringBuffer ) )
+					return false;
+
+				msg.SetPlayerName( stringBuffer );
+				return true;
+			}
+		case LevelName:
+			{
+				if ( !ReadString( stringBuffer ) )
+					return false;
+
+				msg.SetLevelName( stringBuffer );
+				return true;
+			}
+		case Ping:
+			{
+				uint32_t timeStamp = 0;
+
+				if ( !ReadUInt( timeStamp ) )
+					return false;
+
+				msg.SetTimeStamp( timeStamp );
+				return true;
+			}
+		case Pong:
+			{
+				uint32_t timeStamp = 0;
+				uint32_t echoTimeStamp = 0;
+
+				if ( !ReadUInt( timeStamp ) || !ReadUInt( echoTimeStamp ) )
+					return false;
+
+				msg.SetTimeStamp( timeStamp );
+				msg.SetEchoTimeStamp( echoTimeStamp );
+				return true;
+			}
+		case UDPHandshake:
+			{
+				uint32_t port = 0;
+
+				if ( !ReadUInt( port ) )
+					return false;
+
+				msg.SetPort( static_cast< uint16_t > ( port ) );
+				return true;
+			}
+		default:
+			{
+				// There's no way of knowing where the next message starts, so the rest of the buffer is dropped
+				std::cout << "TCPMessageParser.cpp@" << __LINE__ << " Wrong message type : " << type << std::endl;
+				position = length;
+				consumed = length;
+				return false;
+			}
+	}
+}
+bool TCPMessageParser::NextToken( const char* &begin, const char* &end )
+{
+	const char* bufferEnd = data + length;
+	const char* current = data + position;
+
+	while ( current != bufferEnd && std::isspace( static_cast< unsigned char > ( *current ) ) )
+		++current;
+
+	begin = current;
+
+	while ( current != bufferEnd && !std::isspace( static_cast< unsigned char > ( *current ) ) )
+		++current;
+
+	// Every value is followed by a space, if it isn't the rest of it hasn't been recieved yet
+	if ( current == bufferEnd || current == begin )
+		return false;
+
+	end = current;
+	position = static_cast< size_t > ( current - data );
+
+	return true;
+}
+// The tokens are always followed by a space, so strtol and friends stop before the end of the buffer
+bool TCPMessageParser::ReadInt( int32_t &value, char separator )
+{
+	const char* begin = nullptr;
+	const char* end = nullptr;
+
+	if ( !NextToken( begin, end ) )
+		return false;
+
+	char* parsedEnd = nullptr;
+	value = static_cast< int32_t > ( std::strtol( begin, &parsedEnd, 10 ) );
+
+	return IsWholeToken( parsedEnd, end, separator );
+}
+bool TCPMessageParser::ReadUInt( uint32_t &value )
+{
+	const char* begin = nullptr;
+	const char* end = nullptr;
+
+	if ( !NextToken( begin, end ) )
+		return false;
+
+	char* parsedEnd = nullptr;
+	value = static_cast< uint32_t > ( std::strtoul( begin, &parsedEnd, 10 ) );
+
+	return IsWholeToken( parsedEnd, end, '\0' );
+}
+bool TCPMessageParser::ReadDouble( double &value, char separator )
+{
+	const char* begin = nullptr;
+	const char* end = nullptr;
+
+	if ( !NextToken( begin, end ) )
+		return false;
+
+	char* parsedEnd = nullptr;
+	value = std::strtod( begin, &parsedEnd );
+
+	return IsWholeToken( parsedEnd, end, separator );
+}
+bool TCPMessageParser::IsWholeToken( const char* parsedEnd, const char* end, char separator )
+{
+	if ( parsedEnd == end )
+		return true;
+
+	// Something like '12abc' is not a number
+	return separator != '\0' && ( parsedEnd + 1 ) == end && *parsedEnd == separator;
+}
+bool TCPMessageParser::ReadVector2f( Vector2f &vec )
+{
+	// Vectors are written as 'x, y', so the x value ends with a ','
+	return ReadDouble( vec.x, ',' ) && ReadDouble( vec.y );
+}
+bool TCPMessageParser::ReadLogicalPosition( LogicalPosition &pos )
+{
+	// Same as vectors, 'x, y'
+	return ReadInt( pos.x, ',' ) && ReadInt( pos.y );
+}
+bool TCPMessageParser::ReadString( std::string &str )
+{
+	const char* begin = nullptr;
+	const char* end = nullptr;
+
+	if ( !NextToken( begin, end ) )
+		return false;
+
+	str.assign( begin, end );
+	return true;
+}
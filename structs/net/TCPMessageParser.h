@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+class TCPMessage;
+struct Vector2f;
+struct LogicalPosition;
+
+// Reads TCPMessages straight out of a receive buffer
+// Does the same as operator>>( std::istream&, TCPMessage& ), but without copying the data into a stringstream
+// The message that is passed in is reused, so nothing is allocated once its strings have grown large enough
+class TCPMessageParser
+{
+	public:
+		TCPMessageParser();
+
+		// The buffer is only read, it has to stay valid until the parser is done with it
+		void SetBuffer( const char* data_, size_t length_ );
+
+		// Returns false when there is no complete message left in the buffer
+		bool ParseNext( TCPMessage &msg );
+
+		// Number of bytes used by complete messages. The rest is the beginning of a message that hasn't been fully recieved
+		size_t GetConsumed() const;
+
+	private:
+		bool ParseBody( int32_t type, TCPMessage &msg );
+
+		bool NextToken( const char* &begin, const char* &end );
+
+		// separator is a character the token may end with, like the ',' after the x in 'x, y'
+		bool ReadInt( int32_t &value, char separator = '\0' );
+		bool ReadUInt( uint32_t &value );
+		bool ReadDouble( double &value, char separator = '\0' );
+		// The number was all of the token, up to the separator if there is one
+		static bool IsWholeToken( const char* parsedEnd, const char* end, char separator );
+		bool ReadVector2f( Vector2f &vec );
+		bool ReadLogicalPosition( LogicalPosition &pos );
+		bool ReadString( std::string &str );
+
+		const char* data;
+		size_t length;
+		size_t position;
+		size_t consumed;
+
+		// Kept between messages so that reading strings doesn't allocate
+		std::string stringBuffer;
+};
@@ -0,0 +1,210 @@
+#include "UDPConnection.h"
+
+#include "TCPMessageParser.h"
+
+#include "../../Logger.h"
+
+#include <cstring>
+
+UDPConnection::UDPConnection()
+	:	socket( nullptr )
+	,	packet( nullptr )
+	,	remoteAddress()
+	,	hasRemote( false )
+	,	nextSequence( 1 )
+	,	newestSequence()
+	,	droppedStale( 0 )
+	,	simulator()
+	,	simulatedPacket()
+	,	packetSize( 1024 )
+	,	headerSize( 8 )
+{
+	logger = Logger::Instance();
+}
+UDPConnection::~UDPConnection()
+{
+	Close();
+}
+bool UDPConnection::Open( uint16_t localPort )
+{
+	Close();
+
+	socket = SDLNet_UDP_Open( localPort );
+
+	if ( socket == nullptr )
+	{
+		logger->Log( __FILE__, __LINE__, "Failed to open UDP socket : ", SDLNet_GetError() );
+		return false;
+	}
+
+	packet = SDLNet_AllocPacket( packetSize );
+
+	if ( packet == nullptr )
+	{
+		logger->Log( __FILE__, __LINE__, "Failed to allocate UDP packet : ", SDLNet_GetError() );
+		Close();
+		return false;
+	}
+
+	logger->Log( __FILE__, __LINE__, "UDP socket opened on port : ", localPort );
+	return true;
+}
+void UDPConnection::SetRemote( uint32_t host, uint16_t port )
+{
+	// IPaddress is in network byte order, host already is since it comes from SDL_net
+	remoteAddress.host = host;
+	SDLNet_Write16( port, &remoteAddress.port );
+	hasRemote = true;
+
+	nextSequence = 1;
+	newestSequence.clear();
+
+	logger->Log( __FILE__, __LINE__, "UDP remote port set : ", port );
+}
+void UDPConnection::Close()
+{
+	if ( packet != nullptr )
+	{
+		SDLNet_FreePacket( packet );
+		packet = nullptr;
+	}
+
+	if ( socket != nullptr )
+	{
+		SDLNet_UDP_Close( socket );
+		socket = nullptr;
+	}
+
+	hasRemote = false;
+	newestSequence.clear();
+	simulator.Clear();
+}
+bool UDPConnection::IsOpen() const
+{
+	return socket != nullptr;
+}
+bool UDPConnection::HasRemote() const
+{
+	return hasRemote;
+}
+void UDPConnection::Send( const std::string &str, uint32_t streamID )
+{
+	if ( !IsOpen() || !hasRemote )
+		return;
+
+	int messageSize = static_cast< int > ( str.size() );
+
+	if ( ( messageSize + headerSize ) > packet->maxlen )
+	{
+		logger->Log( __FILE__, __LINE__, "Message too large for UDP packet : ", messageSize );
+		return;
+	}
+
+	SDLNet_Write32( nextSequence++, packet->data );
+	SDLNet_Write32( streamID, packet->data + 4 );
+	memcpy( packet->data + headerSize, str.c_str(), str.size() );
+
+	packet->len = messageSize + headerSize;
+
+	if ( simulator.IsActive() )
+	{
+		// Lost datagrams still use up a sequence number, so the reciever sees the gap
+		simulator.Queue( reinterpret_cast< const char* > ( packet->data ), static_cast< size_t > ( packet->len ), false, SDL_GetTicks() );
+		return;
+	}
+
+	SendPacket();
+}
+void UDPConnection::Flush()
+{
+	if ( !IsOpen() || !hasRemote )
+		return;
+
+	uint32_t now = SDL_GetTicks();
+
+	while ( simulator.PopReady( now, simulatedPacket ) )
+	{
+		memcpy( packet->data, simulatedPacket.c_str(), simulatedPacket.size() );
+		packet->len = static_cast< int > ( simulatedPacket.size() );
+
+		SendPacket();
+	}
+}
+void UDPConnection::SendPacket()
+{
+	packet->address = remoteAddress;
+
+	if ( SDLNet_UDP_Send( socket, -1, packet ) == 0 )
+		logger->Log( __FILE__, __LINE__, "UDP send failed : ", SDLNet_GetError() );
+}
+void UDPConnection::SetNetworkConditions( const NetworkConditions &conditions )
+{
+	simulator.SetConditions( conditions );
+}
+bool UDPConnection::ReadMessages( TCPMessageParser &parser )
+{
+	if ( !IsOpen() )
+		return false;
+
+	while ( true )
+	{
+		int result = SDLNet_UDP_Recv( socket, packet );
+
+		if ( result == 0 )
+			return false;
+
+		if ( result < 0 )
+		{
+			logger->Log( __FILE__, __LINE__, "UDP read failed : ", SDLNet_GetError() );
+			return false;
+		}
+
+		if ( packet->len <= headerSize )
+			continue;
+
+		// Only the player we're connected to over TCP can send game state
+		if ( !IsFromRemote() )
+			continue;
+
+		uint32_t sequence = SDLNet_Read32( packet->data );
+		uint32_t streamID = SDLNet_Read32( packet->data + 4 );
+
+		if ( !IsNewer( sequence, streamID ) )
+		{
+			++droppedStale;
+			continue;
+		}
+
+		parser.SetBuffer( reinterpret_cast< const char* > ( packet->data + headerSize ), static_cast< size_t > ( packet->len - headerSize ) );
+		return true;
+	}
+}
+bool UDPConnection::IsFromRemote() const
+{
+	return hasRemote && packet->address.host == remoteAddress.host && packet->address.port == remoteAddress.port;
+}
+bool UDPConnection::IsNewer( uint32_t sequence, uint32_t streamID )
+{
+	auto newest = newestSequence.find( streamID );
+
+	if ( newest == newestSequence.end() )
+	{
+		newestSequence[ streamID ] = sequence;
+		return true;
+	}
+
+	// Signed difference so that the check still works when the sequence number wraps around
+	if ( static_cast< int32_t > ( sequence - newest->second ) <= 0 )
+		return false;
+
+	newest->second = sequence;
+	return true;
+}
+uint64_t UDPConnection::GetDroppedStaleCount() const
+{
+	return droppedStale;
+}
+uint64_t UDPConnection::GetDroppedLossCount() const
+{
+	return simulator.GetLostCount();
+}
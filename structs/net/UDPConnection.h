@@ -0,0 +1,67 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <cstdint>
+
+#include <SDL2/SDL_net.h>
+
+#include "NetworkSimulator.h"
+
+class Logger;
+class TCPMessageParser;
+
+// Unreliable, sequenced channel for messages where only the newest one matters ( paddle position, ball data )
+// Every datagram starts with a sequence number and a stream ID. Datagrams older than the newest one recieved on the same stream are dropped
+// So are datagrams that don't come from the address and port set with SetRemote
+class UDPConnection
+{
+public:
+	UDPConnection();
+	~UDPConnection();
+
+	bool Open( uint16_t localPort );
+	void SetRemote( uint32_t host, uint16_t port );
+	void Close();
+
+	bool IsOpen() const;
+	bool HasRemote() const;
+
+	void Send( const std::string &str, uint32_t streamID );
+
+	// Recieves one datagram and points the parser to it. Returns false if there was nothing ( new ) to read
+	bool ReadMessages( TCPMessageParser &parser );
+
+	// Sends what the network simulator has held back long enough
+	void Flush();
+	void SetNetworkConditions( const NetworkConditions &conditions );
+
+	uint64_t GetDroppedStaleCount() const;
+	uint64_t GetDroppedLossCount() const;
+
+private:
+	bool IsFromRemote() const;
+	bool IsNewer( uint32_t sequence, uint32_t streamID );
+	void SendPacket();
+
+	UDPsocket socket;
+	UDPpacket* packet;
+	IPaddress remoteAddress;
+	bool hasRemote;
+
+	uint32_t nextSequence;
+	std::map< uint32_t, uint32_t > newestSequence;
+
+	uint64_t droppedStale;
+
+	NetworkSimulator simulator;
+	std::string simulatedPacket;
+
+	const int packetSize;
+	const int headerSize;
+
+	Logger *logger;
+
+	UDPConnection( const UDPConnection &other );
+	UDPConnection& operator=( const UDPConnection &other );
+};
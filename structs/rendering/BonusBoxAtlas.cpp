@@ -0,0 +1,96 @@
+#include "BonusBoxAtlas.h"
+#include "DrawList.h"
+
+#include "../../tools/RenderTools.h"
+#include "../game_objects/BonusBox.h"
+#include "../../math/ViewTransform.h"
+
+#include <iostream>
+#include <initializer_list>
+
+BonusBoxAtlas::BonusBoxAtlas()
+	:	texture( nullptr )
+	,	size( 0 )
+{
+}
+BonusBoxAtlas::~BonusBoxAtlas()
+{
+	Destroy();
+}
+bool BonusBoxAtlas::Create(
+	SDL_Renderer* renderer,
+	int32_t boxSize,
+	const SDL_Color &localColor,
+	const SDL_Color &remoteColor,
+	const std::map< BonusType, SDL_Color > &bonusColors
+)
+{
+	Destroy();
+
+	size = boxSize;
+
+	// One row per player, one column per bonus type
+	// A pixel of space between the boxes so that scaling doesn't bleed one into the next
+	int32_t width = static_cast< int32_t > ( bonusTypeCount ) * ( size + 1 );
+	int32_t height = static_cast< int32_t > ( playerCount ) * ( size + 1 );
+
+	SDL_Surface* atlas = RenderHelpers::CreateRGBASurface( width, height );
+
+	if ( atlas == nullptr )
+	{
+		std::cout << "BonusBoxAtlas@" << __LINE__ << " Failed to create bonus box atlas : " << SDL_GetError() << std::endl;
+		return false;
+	}
+
+	int32_t margin = size / 8;
+
+	for ( size_t i = 0; i < bonusTypeCount; ++i )
+	{
+		BonusType bonusType = static_cast< BonusType > ( i );
+
+		auto bonusColor = bonusColors.find( bonusType );
+		SDL_Color innerColor = ( bonusColor != bonusColors.end() ) ? bonusColor->second : SDL_Color{ 0, 0, 0, 0 };
+
+		for ( Player owner : { Player::Local, Player::Remote } )
+		{
+			SDL_Rect box = GetRegion( owner, bonusType );
+			SDL_Rect icon = { box.x + margin, box.y + margin, size - ( margin * 2 ), size - ( margin * 2 ) };
+
+			const SDL_Color &outerColor = ( owner == Player::Local ) ? localColor : remoteColor;
+
+			SDL_FillRect( atlas, &box, RenderHelpers::MapRGBA( atlas->format, outerColor ) );
+			SDL_FillRect( atlas, &icon, RenderHelpers::MapRGBA( atlas->format, innerColor ) );
+		}
+	}
+
+	texture = RenderHelpers::CreateTexture( renderer, atlas );
+	SDL_FreeSurface( atlas );
+
+	if ( texture == nullptr )
+	{
+		std::cout << "BonusBoxAtlas@" << __LINE__ << " Failed to create bonus box atlas texture : " << SDL_GetError() << std::endl;
+		return false;
+	}
+
+	return true;
+}
+void BonusBoxAtlas::Destroy()
+{
+	RenderHelpers::DestroyTexture( texture );
+	texture = nullptr;
+}
+void BonusBoxAtlas::Render( DrawList &drawList, const BonusBox &bonusBox, const ViewTransform &view ) const
+{
+	if ( texture == nullptr )
+		return;
+
+	SDL_Rect source = GetRegion( bonusBox.GetOwner(), bonusBox.GetBonusType() );
+	drawList.Copy( texture, &source, view.ToScreen( bonusBox.rect ) );
+}
+SDL_Rect BonusBoxAtlas::GetRegion( const Player &owner, const BonusType &bonusType ) const
+{
+	int32_t column = static_cast< int32_t > ( bonusType );
+	int32_t row = ( owner == Player::Local ) ? 0 : 1;
+
+	return { column * ( size + 1 ), row * ( size + 1 ), size, size };
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <map>
+#include <cstdint>
+
+#include <SDL2/SDL.h>
+
+#include "enums/Player.h"
+#include "enums/BonusType.h"
+
+class DrawList;
+class ViewTransform;
+struct BonusBox;
+
+// Every bonus box look ( owner color around a bonus type color ) in a single texture, built once
+// Spawning a bonus box doesn't create anything, all boxes are drawn from their region of the atlas
+// Has to be created again when the player or bonus colors change
+class BonusBoxAtlas
+{
+	public:
+		BonusBoxAtlas();
+		~BonusBoxAtlas();
+
+		bool Create(
+			SDL_Renderer* renderer,
+			int32_t boxSize,
+			const SDL_Color &localColor,
+			const SDL_Color &remoteColor,
+			const std::map< BonusType, SDL_Color > &bonusColors
+		);
+		void Destroy();
+
+		void Render( DrawList &drawList, const BonusBox &bonusBox, const ViewTransform &view ) const;
+
+	private:
+		static const size_t bonusTypeCount = static_cast< size_t > ( BonusType::Count );
+		static const size_t playerCount = 2;
+
+		SDL_Rect GetRegion( const Player &owner, const BonusType &bonusType ) const;
+
+		SDL_Texture* texture;
+		int32_t size;
+
+		BonusBoxAtlas( const BonusBoxAtlas &other );
+		BonusBoxAtlas& operator=( const BonusBoxAtlas &other );
+};
@@ -0,0 +1,103 @@
+#include "DrawList.h"
+
+DrawList::DrawList()
+	:	commands()
+{
+}
+void DrawList::SetDrawColor( const SDL_Color &color )
+{
+	Add( CommandType::SetDrawColor ).color = color;
+}
+void DrawList::RenderClear()
+{
+	Add( CommandType::RenderClear );
+}
+void DrawList::FillRect( const SDL_Rect &rect )
+{
+	Command &command = Add( CommandType::FillRect );
+	command.target = rect;
+	command.hasTarget = true;
+}
+void DrawList::Copy( SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect &target )
+{
+	Copy( texture, source, target, { 255, 255, 255, 255 } );
+}
+void DrawList::Copy( SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect &target, const SDL_Color &color )
+{
+	if ( texture == nullptr )
+		return;
+
+	Command &command = Add( CommandType::Copy );
+	command.texture = texture;
+	command.target = target;
+	command.hasTarget = true;
+	command.color = color;
+
+	if ( source != nullptr )
+	{
+		command.source = *source;
+		command.hasSource = true;
+	}
+}
+void DrawList::SetClipRect( const SDL_Rect* rect )
+{
+	Command &command = Add( CommandType::SetClipRect );
+
+	if ( rect != nullptr )
+	{
+		command.target = *rect;
+		command.hasTarget = true;
+	}
+}
+void DrawList::SetTarget( SDL_Texture* texture )
+{
+	Add( CommandType::SetTarget ).texture = texture;
+}
+void DrawList::Append( const DrawList &other )
+{
+	commands.insert( commands.end(), other.commands.begin(), other.commands.end() );
+}
+void DrawList::Clear()
+{
+	// Keeps the memory, so recording the next frame doesn't allocate
+	commands.clear();
+}
+bool DrawList::IsEmpty() const
+{
+	return commands.empty();
+}
+void DrawList::Play( SDL_Renderer* renderer ) const
+{
+	for ( const auto &command : commands )
+	{
+		switch ( command.type )
+		{
+			case CommandType::SetDrawColor:
+				SDL_SetRenderDrawColor( renderer, command.color.r, command.color.g, command.color.b, command.color.a );
+				break;
+			case CommandType::RenderClear:
+				SDL_RenderClear( renderer );
+				break;
+			case CommandType::FillRect:
+				SDL_RenderFillRect( renderer, &command.target );
+				break;
+			case CommandType::Copy:
+				// The mods belong to the texture, so they're set for every copy to not carry over from the last one
+				SDL_SetTextureColorMod( command.texture, command.color.r, command.color.g, command.color.b );
+				SDL_SetTextureAlphaMod( command.texture, command.color.a );
+				SDL_RenderCopy( renderer, command.texture, command.hasSource ? &command.source : nullptr, &command.target );
+				break;
+			case CommandType::SetClipRect:
+				SDL_RenderSetClipRect( renderer, command.hasTarget ? &command.target : nullptr );
+				break;
+			case CommandType::SetTarget:
+				SDL_SetRenderTarget( renderer, command.texture );
+				break;
+		}
+	}
+}
+DrawList::Command& DrawList::Add( CommandType type )
+{
+	commands.push_back( { type, nullptr, { 0, 0, 0, 0 }, { 0, 0, 0, 0 }, { 255, 255, 255, 255 }, false, false } );
+	return commands.back();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+// The draw calls of a frame, recorded by the Renderer and played back later, possibly on another thread
+// Only holds plain values and texture pointers, so changes to the game after recording don't affect what gets drawn
+class DrawList
+{
+	public:
+		DrawList();
+
+		void SetDrawColor( const SDL_Color &color );
+		void RenderClear();
+		void FillRect( const SDL_Rect &rect );
+
+		// Without a color, the texture is drawn as is
+		// Otherwise the color is applied as color mod and the alpha as alpha mod
+		void Copy( SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect &target );
+		void Copy( SDL_Texture* texture, const SDL_Rect* source, const SDL_Rect &target, const SDL_Color &color );
+
+		// nullptr turns clipping off
+		void SetClipRect( const SDL_Rect* rect );
+		// nullptr is the screen
+		void SetTarget( SDL_Texture* texture );
+
+		void Append( const DrawList &other );
+		void Clear();
+		bool IsEmpty() const;
+
+		void Play( SDL_Renderer* renderer ) const;
+
+	private:
+		enum class CommandType
+		{
+			SetDrawColor,
+			RenderClear,
+			FillRect,
+			Copy,
+			SetClipRect,
+			SetTarget
+		};
+
+		struct Command
+		{
+			CommandType type;
+			SDL_Texture* texture;
+			SDL_Rect source;
+			SDL_Rect target;
+			SDL_Color color;
+			bool hasSource;
+			bool hasTarget;
+		};
+
+		Command& Add( CommandType type );
+
+		std::vector< Command > commands;
+};
@@ -0,0 +1,123 @@
+#include "GlyphAtlas.h"
+#include "DrawList.h"
+
+#include "../../tools/RenderTools.h"
+
+#include <iostream>
+
+GlyphAtlas::GlyphAtlas()
+	:	texture( nullptr )
+	,	glyphs()
+	,	advances()
+	,	height( 0 )
+{
+}
+GlyphAtlas::~GlyphAtlas()
+{
+	Destroy();
+}
+bool GlyphAtlas::Create( SDL_Renderer* renderer, TTF_Font* font )
+{
+	Destroy();
+
+	SDL_Color white = { 255, 255, 255, 255 };
+	SDL_Surface* glyphSurfaces[ glyphCount ] = { };
+	int32_t width = 0;
+
+	height = TTF_FontHeight( font );
+
+	for ( size_t i = 0; i < glyphCount; ++i )
+	{
+		uint16_t ch = static_cast< uint16_t > ( firstGlyph + static_cast< char > ( i ) );
+		int minX = 0, maxX = 0, minY = 0, maxY = 0, advance = 0;
+
+		TTF_GlyphMetrics( font, ch, &minX, &maxX, &minY, &maxY, &advance );
+		advances[i] = advance;
+
+		glyphSurfaces[i] = TTF_RenderGlyph_Blended( font, ch, white );
+
+		int32_t glyphWidth = ( glyphSurfaces[i] != nullptr ) ? glyphSurfaces[i]->w : 0;
+		glyphs[i] = { width, 0, glyphWidth, height };
+
+		// A pixel of space between the glyphs so that scaling doesn't bleed one into the next
+		width += glyphWidth + 1;
+	}
+
+	SDL_Surface* atlas = RenderHelpers::CreateRGBASurface( width, height );
+
+	for ( size_t i = 0; i < glyphCount; ++i )
+	{
+		if ( glyphSurfaces[i] == nullptr )
+			continue;
+
+		// Copies the alpha channel as well, instead of blending it onto the empty atlas
+		SDL_SetSurfaceBlendMode( glyphSurfaces[i], SDL_BLENDMODE_NONE );
+
+		if ( atlas != nullptr )
+			SDL_BlitSurface( glyphSurfaces[i], nullptr, atlas, &glyphs[i] );
+
+		SDL_FreeSurface( glyphSurfaces[i] );
+	}
+
+	if ( atlas == nullptr )
+	{
+		std::cout << "GlyphAtlas@" << __LINE__ << " Failed to create glyph atlas : " << SDL_GetError() << std::endl;
+		return false;
+	}
+
+	texture = RenderHelpers::CreateTexture( renderer, atlas );
+	SDL_FreeSurface( atlas );
+
+	if ( texture == nullptr )
+	{
+		std::cout << "GlyphAtlas@" << __LINE__ << " Failed to create glyph atlas texture : " << SDL_GetError() << std::endl;
+		return false;
+	}
+
+	SDL_SetTextureBlendMode( texture, SDL_BLENDMODE_BLEND );
+	return true;
+}
+void GlyphAtlas::Destroy()
+{
+	RenderHelpers::DestroyTexture( texture );
+	texture = nullptr;
+}
+int32_t GlyphAtlas::GetTextWidth( const std::string &text ) const
+{
+	int32_t width = 0;
+
+	for ( char ch : text )
+	{
+		if ( IsInAtlas( ch ) )
+			width += advances[ static_cast< size_t > ( ch - firstGlyph ) ];
+	}
+
+	return width;
+}
+int32_t GlyphAtlas::GetHeight() const
+{
+	return height;
+}
+void GlyphAtlas::Render( DrawList &drawList, const std::string &text, int32_t x, int32_t y, const SDL_Color &color ) const
+{
+	if ( texture == nullptr )
+		return;
+
+	SDL_Color colorMod = { color.r, color.g, color.b, 255 };
+
+	for ( char ch : text )
+	{
+		if ( !IsInAtlas( ch ) )
+			continue;
+
+		size_t index = static_cast< size_t > ( ch - firstGlyph );
+		SDL_Rect target = { x, y, glyphs[ index ].w, glyphs[ index ].h };
+
+		drawList.Copy( texture, &glyphs[ index ], target, colorMod );
+		x += advances[ index ];
+	}
+}
+bool GlyphAtlas::IsInAtlas( char ch ) const
+{
+	return ch >= firstGlyph && ch <= lastGlyph;
+}
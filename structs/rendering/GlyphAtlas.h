@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+class DrawList;
+
+// All printable ASCII glyphs of one font ( and size ) in a single texture, rendered once with SDL_ttf
+// Text is drawn by copying one quad per character, so changing the text never touches SDL_ttf or creates a texture
+// The glyphs are white, the color is applied as a color mod when rendering
+class GlyphAtlas
+{
+	public:
+		GlyphAtlas();
+		~GlyphAtlas();
+
+		bool Create( SDL_Renderer* renderer, TTF_Font* font );
+		void Destroy();
+
+		// Kerning is ignored, which makes no visible difference for the HUD strings
+		int32_t GetTextWidth( const std::string &text ) const;
+		int32_t GetHeight() const;
+
+		void Render( DrawList &drawList, const std::string &text, int32_t x, int32_t y, const SDL_Color &color ) const;
+
+	private:
+		static const char firstGlyph = ' ';
+		static const char lastGlyph = '~';
+		static const size_t glyphCount = lastGlyph - firstGlyph + 1;
+
+		bool IsInAtlas( char ch ) const;
+
+		SDL_Texture* texture;
+		SDL_Rect glyphs[ glyphCount ];
+		int32_t advances[ glyphCount ];
+		int32_t height;
+
+		GlyphAtlas( const GlyphAtlas &other );
+		GlyphAtlas& operator=( const GlyphAtlas &other );
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+#include <SDL2/SDL.h>
+
+#include "GlyphAtlas.h"
+
+// A caption followed by a number, like "Points : 1234", drawn from a GlyphAtlas
+// Used for the HUD values that change all the time. The string keeps its capacity, so a new value doesn't allocate either
+struct GlyphText
+{
+	GlyphText()
+		:	caption()
+		,	text()
+		,	rect{ 0, 0, 0, 0 }
+		,	color{ 255, 255, 255, 255 }
+		,	value( 0 )
+		,	hasValue( false )
+	{
+		text.reserve( 32 );
+	}
+
+	void SetCaption( const std::string &caption_ )
+	{
+		caption = caption_;
+		hasValue = false;
+	}
+
+	// Returns false if the value is the same as before
+	bool SetValue( uint64_t value_, const GlyphAtlas &atlas )
+	{
+		if ( hasValue && value == value_ )
+			return false;
+
+		value = value_;
+		hasValue = true;
+
+		text.assign( caption );
+		AppendNumber( value );
+
+		rect.w = atlas.GetTextWidth( text );
+		rect.h = atlas.GetHeight();
+
+		return true;
+	}
+
+	void Render( DrawList &drawList, const GlyphAtlas &atlas ) const
+	{
+		atlas.Render( drawList, text, rect.x, rect.y, color );
+	}
+
+	std::string caption;
+	std::string text;
+	SDL_Rect rect;
+	SDL_Color color;
+
+	private:
+	void AppendNumber( uint64_t number )
+	{
+		char digits[ 20 ];
+		size_t count = 0;
+
+		do
+		{
+			digits[ count++ ] = static_cast< char > ( '0' + ( number % 10 ) );
+			number /= 10;
+		} while ( number > 0 );
+
+		while ( count > 0 )
+			text.push_back( digits[ --count ] );
+	}
+
+	uint64_t value;
+	bool hasValue;
+};
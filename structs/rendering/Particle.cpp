@@ -1,31 +1,21 @@
 #include "Particle.h"
 
 Particle::Particle()
-	:	Particle( {0,0,0,0}, { 0, 0, 0, 0 } )
+	:	Particle( {0,0,0,0}, { 0, 0, 0, 0 }, Vector2f( 0.0, 0.0 ), 0.0, 0.0 )
 {
 	isAlive = false;
 }
-Particle::Particle( Rect r, SDL_Color  clr )
+Particle::Particle( Rect r, SDL_Color  clr, const Vector2f &dir_, double decay_, double speed_ )
 {
 	rect = r;
 	color = clr;
 
-	dir.x = RandomHelper::GenRandomNumber( -1.0, 1.0 );
-	dir.y = RandomHelper::GenRandomNumber( -1.0, 1.0 );
-
-	SetDecay( 0.0, 1.0 );
-	SetSpeed( 0.0, 1.0 );
+	dir = dir_;
+	decay = decay_;
+	speed = speed_;
 
 	isAlive = true;
 }
-void Particle::SetDecay( double min, double max )
-{
-	decay = RandomHelper::GenRandomNumber( min, max );
-}
-void Particle::SetSpeed( double min, double max )
-{
-	speed =  RandomHelper::GenRandomNumber( min, max );
-}
 void Particle::Updated( double delta )
 {
 	if ( !isAlive )
@@ -3,16 +3,13 @@
 #include <SDL2/SDL.h>
 #include "../math/Rect.h"
 #include "../math/Vector2f.h"
-#include "../math/Math.h"
 
 struct Particle
 {
 	Particle();
 
-	Particle( Rect r, SDL_Color  clr );
-
-	void SetDecay( double min, double max );
-	void SetSpeed( double min, double max );
+	// The random values are generated by the Renderer, many at a time
+	Particle( Rect r, SDL_Color  clr, const Vector2f &dir_, double decay_, double speed_ );
 
 	void Updated( double delta );
 
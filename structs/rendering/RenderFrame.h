@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "DrawList.h"
+
+// Everything needed to draw one frame. The game records it, the render thread draws it ( see RenderThread )
+struct RenderFrame
+{
+	RenderFrame()
+		:	targetUpdates()
+		,	screen()
+		,	deadTextures()
+	{
+	}
+
+	void Clear()
+	{
+		targetUpdates.Clear();
+		screen.Clear();
+		deadTextures.clear();
+	}
+
+	// Drawing into render targets, like the TileLayer. Every update builds on the ones before it,
+	// so unlike the rest of the frame these are never skipped
+	DrawList targetUpdates;
+
+	DrawList screen;
+
+	// Textures the game stopped using before this frame was recorded. Destroyed once it has been drawn
+	std::vector< SDL_Texture* > deadTextures;
+};
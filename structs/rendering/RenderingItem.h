@@ -14,6 +14,7 @@ template < class Value > class RenderingItem
 			,	value( )
 			,	doFade( false )
 			,	alpha( 255 )
+			,	textureAlpha( 255 )
 			{
 				texture = nullptr;
 			}
@@ -24,8 +25,9 @@ template < class Value > class RenderingItem
 		}
 		void DestroyTexture()
 		{
-			SDL_DestroyTexture( texture );
+			RenderHelpers::DestroyTexture( texture );
 			texture = nullptr;
+			textureAlpha = 255;
 		}
 		void Reset( SDL_Renderer* renderer, TTF_Font* font, const SDL_Color &color )
 		{
@@ -58,13 +60,13 @@ template < class Value > class RenderingItem
 				doFade = false;
 			} else
 			{
-				SDL_SetTextureAlphaMod( texture, alpha );
+				textureAlpha = alpha;
 			}
 		}
 		void ResetAlpha()
 		{
 			alpha = 255;
-			SDL_SetTextureAlphaMod( texture, alpha );
+			textureAlpha = alpha;
 		}
 		void StartFade()
 		{
@@ -95,4 +97,7 @@ template < class Value > class RenderingItem
 
 		bool doFade;
 		uint8_t alpha;
+
+		// Alpha mod used when drawing the texture. Stays where the fade left it until ResetAlpha()
+		uint8_t textureAlpha;
 };
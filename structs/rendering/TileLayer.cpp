@@ -0,0 +1,123 @@
+#include "TileLayer.h"
+#include "RenderFrame.h"
+
+#include "../game_objects/Tile.h"
+#include "../../tools/RenderTools.h"
+#include "../../math/ViewTransform.h"
+
+#include <iostream>
+
+TileLayer::TileLayer()
+	:	texture( nullptr )
+	,	size{ 0, 0, 0, 0 }
+	,	dirtyRects()
+	,	allDirty( true )
+{
+	dirtyRects.reserve( maxDirtyRects );
+}
+TileLayer::~TileLayer()
+{
+	Destroy();
+}
+bool TileLayer::Create( SDL_Renderer* renderer, int32_t width, int32_t height )
+{
+	Destroy();
+
+	size = { 0, 0, width, height };
+	MarkAllDirty();
+
+	if ( !SDL_RenderTargetSupported( renderer ) )
+	{
+		std::cout << "TileLayer@" << __LINE__ << " Render targets not supported, tiles will be drawn every frame" << std::endl;
+		return false;
+	}
+
+	texture = SDL_CreateTexture( renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height );
+
+	if ( texture == nullptr )
+	{
+		std::cout << "TileLayer@" << __LINE__ << " Failed to create tile layer : " << SDL_GetError() << std::endl;
+		return false;
+	}
+
+	// The layer includes the background, so it replaces whatever is on the screen
+	SDL_SetTextureBlendMode( texture, SDL_BLENDMODE_NONE );
+	return true;
+}
+void TileLayer::Destroy()
+{
+	RenderHelpers::DestroyTexture( texture );
+	texture = nullptr;
+}
+void TileLayer::MarkDirty( const SDL_Rect &rect )
+{
+	if ( allDirty )
+		return;
+
+	if ( dirtyRects.size() >= maxDirtyRects )
+	{
+		MarkAllDirty();
+		return;
+	}
+
+	dirtyRects.push_back( rect );
+}
+void TileLayer::MarkAllDirty()
+{
+	allDirty = true;
+	dirtyRects.clear();
+}
+void TileLayer::Render( RenderFrame &frame, const std::vector< std::shared_ptr< Tile > > &tiles, const ViewTransform &view, const SDL_Color &backgroundColor )
+{
+	if ( texture == nullptr )
+	{
+		for ( const auto &tile : tiles )
+			RenderHelpers::RenderGamePiece( frame.screen, tile, view );
+
+		return;
+	}
+
+	if ( allDirty || !dirtyRects.empty() )
+		Update( frame.targetUpdates, tiles, view, backgroundColor );
+
+	frame.screen.Copy( texture, nullptr, size );
+}
+void TileLayer::Update( DrawList &drawList, const std::vector< std::shared_ptr< Tile > > &tiles, const ViewTransform &view, const SDL_Color &backgroundColor )
+{
+	drawList.SetTarget( texture );
+	drawList.SetDrawColor( backgroundColor );
+
+	if ( allDirty )
+	{
+		drawList.RenderClear();
+
+		for ( const auto &tile : tiles )
+			RenderHelpers::RenderGamePiece( drawList, tile, view );
+	}
+	else
+	{
+		for ( const auto &rect : dirtyRects )
+			RedrawRect( drawList, tiles, view, rect );
+
+		drawList.SetClipRect( nullptr );
+	}
+
+	drawList.SetTarget( nullptr );
+
+	allDirty = false;
+	dirtyRects.clear();
+}
+void TileLayer::RedrawRect( DrawList &drawList, const std::vector< std::shared_ptr< Tile > > &tiles, const ViewTransform &view, const SDL_Rect &rect )
+{
+	// Clipped, so that a tile only partly inside the rect isn't blended on top of itself outside it
+	drawList.SetClipRect( &rect );
+	drawList.FillRect( rect );
+
+	for ( const auto &tile : tiles )
+	{
+		SDL_Rect tileRect = view.ToScreen( tile->rect );
+
+		if ( SDL_HasIntersection( &tileRect, &rect ) )
+			RenderHelpers::RenderGamePiece( drawList, tile, view );
+	}
+}
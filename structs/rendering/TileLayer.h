@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+struct Tile;
+struct RenderFrame;
+class DrawList;
+class ViewTransform;
+
+// The background and every live tile, kept in one render target texture
+// Tiles never move, so the layer is only redrawn where a tile was added, hit or removed, and a frame just copies the whole texture
+// Falls back to drawing the tiles directly if the renderer has no support for render targets
+class TileLayer
+{
+	public:
+		TileLayer();
+		~TileLayer();
+
+		bool Create( SDL_Renderer* renderer, int32_t width, int32_t height );
+		void Destroy();
+
+		// rect is on the screen, not in the field
+		void MarkDirty( const SDL_Rect &rect );
+		// Redraws everything, for a new board or when SDL has thrown away the contents of the texture
+		void MarkAllDirty();
+
+		// Draws the dirty parts of the layer, then copies the layer to the screen
+		void Render( RenderFrame &frame, const std::vector< std::shared_ptr< Tile > > &tiles, const ViewTransform &view, const SDL_Color &backgroundColor );
+
+	private:
+		void Update( DrawList &drawList, const std::vector< std::shared_ptr< Tile > > &tiles, const ViewTransform &view, const SDL_Color &backgroundColor );
+		void RedrawRect( DrawList &drawList, const std::vector< std::shared_ptr< Tile > > &tiles, const ViewTransform &view, const SDL_Rect &rect );
+
+		// More dirty rects than this in one frame, and it's cheaper to just redraw the whole layer
+		static const size_t maxDirtyRects = 64;
+
+		SDL_Texture* texture;
+		SDL_Rect size;
+		std::vector< SDL_Rect > dirtyRects;
+		bool allDirty;
+
+		TileLayer( const TileLayer &other );
+		TileLayer& operator=( const TileLayer &other );
+};
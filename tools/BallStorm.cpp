@@ -0,0 +1,152 @@
+#include "BallStorm.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+BallStorm::BallStorm()
+	:	maxBalls( 0 )
+	,	framesPerStep( 0 )
+	,	startResidentBytes( 0 )
+	,	steps()
+	,	isDone( false )
+{
+}
+void BallStorm::Start( uint32_t maxBalls_, uint32_t framesPerStep_ )
+{
+	maxBalls = maxBalls_;
+	framesPerStep = std::max( framesPerStep_, 1u );
+	startResidentBytes = ReadResidentBytes();
+
+	steps.clear();
+	steps.push_back( Step( std::min( 100u, maxBalls ) ) );
+
+	isDone = ( maxBalls == 0 );
+}
+bool BallStorm::IsRunning() const
+{
+	return !steps.empty() && !isDone;
+}
+uint32_t BallStorm::GetBallCount() const
+{
+	if ( steps.empty() )
+		return 0;
+
+	return steps.back().ballCount;
+}
+void BallStorm::AddFrame( double updateSeconds, double renderSeconds, uint64_t collisionTests )
+{
+	if ( !IsRunning() )
+		return;
+
+	Step &step = steps.back();
+
+	if ( step.frames == 0 )
+		step.residentBytes = ReadResidentBytes();
+
+	++step.frames;
+	step.updateSeconds += updateSeconds;
+	step.updateMax = std::max( step.updateMax, updateSeconds );
+	step.renderSeconds += renderSeconds;
+	step.renderMax = std::max( step.renderMax, renderSeconds );
+	step.collisionTests += collisionTests;
+
+	if ( step.frames < framesPerStep )
+		return;
+
+	if ( step.ballCount >= maxBalls )
+		isDone = true;
+	else
+		steps.push_back( Step( std::min( NextBallCount( step.ballCount ), maxBalls ) ) );
+}
+void BallStorm::WriteCSV( std::ostream &out ) const
+{
+	out << "balls,frames,update_ms_avg,update_ms_max,render_ms_avg,render_ms_max,collision_tests_per_frame,bytes_per_ball\n";
+
+	for ( size_t i = 0; i < steps.size(); ++i )
+	{
+		const Step &step = steps[ i ];
+
+		if ( step.frames == 0 )
+			continue;
+
+		double frames = static_cast< double > ( step.frames );
+
+		out << step.ballCount
+			<< "," << step.frames
+			<< "," << std::fixed << std::setprecision( 4 )
+			<< ( step.updateSeconds * 1000.0 / frames )
+			<< "," << ( step.updateMax * 1000.0 )
+			<< "," << ( step.renderSeconds * 1000.0 / frames )
+			<< "," << ( step.renderMax * 1000.0 )
+			<< "," << std::setprecision( 1 ) << ( static_cast< double > ( step.collisionTests ) / frames )
+			<< "," << GetBytesPerBall( i )
+			<< std::defaultfloat << std::setprecision( 6 )
+			<< "\n";
+	}
+}
+bool BallStorm::WriteCSV( const std::string &fileName ) const
+{
+	std::ofstream file( fileName );
+
+	if ( !file.is_open() )
+	{
+		std::cout << "Can't write ball storm results to : " << fileName << std::endl;
+		return false;
+	}
+
+	WriteCSV( file );
+	return true;
+}
+double BallStorm::GetBytesPerBall( size_t stepIndex ) const
+{
+	const Step &step = steps[ stepIndex ];
+
+	uint64_t residentBefore = ( stepIndex == 0 ) ? startResidentBytes : steps[ stepIndex - 1 ].residentBytes;
+	uint32_t ballsBefore = ( stepIndex == 0 ) ? 0 : steps[ stepIndex - 1 ].ballCount;
+
+	if ( step.residentBytes == 0 || residentBefore == 0 || step.ballCount <= ballsBefore )
+		return 0.0;
+
+	// Signed, the allocator can give memory back between steps
+	double grown = static_cast< double > ( step.residentBytes ) - static_cast< double > ( residentBefore );
+
+	return grown / static_cast< double > ( step.ballCount - ballsBefore );
+}
+uint64_t BallStorm::ReadResidentBytes()
+{
+#if defined(__linux__)
+	// Total and resident size, in pages
+	std::ifstream statm( "/proc/self/statm" );
+	uint64_t totalPages = 0;
+	uint64_t residentPages = 0;
+
+	if ( !( statm >> totalPages >> residentPages ) )
+		return 0;
+
+	return residentPages * static_cast< uint64_t > ( sysconf( _SC_PAGESIZE ) );
+#else
+	return 0;
+#endif
+}
+uint32_t BallStorm::NextBallCount( uint32_t count )
+{
+	uint32_t magnitude = 1;
+
+	while ( magnitude <= count / 10 )
+		magnitude *= 10;
+
+	uint32_t leading = count / magnitude;
+
+	if ( leading < 2 )
+		return 2 * magnitude;
+	else if ( leading < 5 )
+		return 5 * magnitude;
+	else
+		return 10 * magnitude;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iosfwd>
+
+// Measures how the game scales with the number of balls. Used headless by -benchmark ballstorm, and in a game by -ballstorm
+//
+// The ball count goes 100, 200, 500, 1000, 2000, 5000 ... and ends at the max. Whoever runs the storm keeps GetBallCount() balls alive
+// and reports every frame, after framesPerStep frames the storm moves on to the next count
+// The result is one CSV row per ball count, so runs from different builds can be compared
+class BallStorm
+{
+	public:
+		BallStorm();
+
+		void Start( uint32_t maxBalls_, uint32_t framesPerStep_ );
+		// Started, and not done with the last step yet
+		bool IsRunning() const;
+
+		uint32_t GetBallCount() const;
+
+		void AddFrame( double updateSeconds, double renderSeconds, uint64_t collisionTests );
+
+		void WriteCSV( std::ostream &out ) const;
+		bool WriteCSV( const std::string &fileName ) const;
+
+	private:
+		struct Step
+		{
+			Step( uint32_t ballCount_ )
+				:	ballCount( ballCount_ )
+				,	frames( 0 )
+				,	updateSeconds( 0.0 )
+				,	updateMax( 0.0 )
+				,	renderSeconds( 0.0 )
+				,	renderMax( 0.0 )
+				,	collisionTests( 0 )
+				,	residentBytes( 0 )
+			{
+			}
+			uint32_t ballCount;
+			uint32_t frames;
+			double updateSeconds;
+			double updateMax;
+			double renderSeconds;
+			double renderMax;
+			uint64_t collisionTests;
+			// Taken on the first frame, when the balls for this step have been added
+			uint64_t residentBytes;
+		};
+
+		// 1, 2, 5, 10, 20, 50 ...
+		static uint32_t NextBallCount( uint32_t count );
+		// The resident set size of the process, 0 where it can't be read
+		static uint64_t ReadResidentBytes();
+		// How much the resident memory grew for each ball added since the step before, 0 if it can't be read
+		double GetBytesPerBall( size_t stepIndex ) const;
+
+		uint32_t maxBalls;
+		uint32_t framesPerStep;
+		// Before any balls were added
+		uint64_t startResidentBytes;
+
+		std::vector< Step > steps;
+		bool isDone;
+};
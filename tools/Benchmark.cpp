@@ -0,0 +1,502 @@
+#include "Benchmark.h"
+
+#include "structs/net/TCPMessage.h"
+#include "structs/net/TCPMessageParser.h"
+
+#include "math/RandomService.h"
+#include "math/ViewTransform.h"
+#include "math/LogicalPosition.h"
+
+#include "structs/game_objects/Ball.h"
+#include "structs/game_objects/Tile.h"
+#include "structs/game_objects/Paddle.h"
+
+#include "structs/PlayerInfo.h"
+
+#include "tools/BallStorm.h"
+
+#include "BoardLoader.h"
+#include "BoardGenerator.h"
+#include "GameRules.h"
+#include "NetManager.h"
+#include "ConfigLoader.h"
+#include "MessageSender.h"
+#include "PhysicsManager.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <initializer_list>
+
+namespace
+{
+	// A board with all its tiles, and two AI paddles. Nothing is rendered or sent anywhere
+	// The tiles are indestructible, so every frame plays out on the same board
+	struct BenchmarkBoard
+	{
+		BenchmarkBoard();
+
+		// The first board in boards/boardlist.txt if board is empty
+		bool Load( const std::string &board );
+		void MovePaddles();
+
+		SDL_Rect windowSize;
+		double tickLength;
+
+		ConfigLoader config;
+		// PhysicsManager needs a MessageSender, this one never connects anywhere
+		NetManager netManager;
+		MessageSender messageSender;
+		PhysicsManager physicsManager;
+
+		std::shared_ptr< Paddle > localPaddle;
+		std::shared_ptr< Paddle > remotePaddle;
+
+		PlayerInfo localPlayerInfo;
+		PlayerInfo remotePlayerInfo;
+		GameRules gameRules;
+
+		std::string levelName;
+	};
+	// The board is indestructible, so hitting a tile is all that happens
+	class TileHitCounter : public GameRulesListener
+	{
+		public:
+		TileHitCounter()
+			:	tileHits( 0 )
+		{
+		}
+		virtual void OnBallHitTile( const std::shared_ptr< Ball > &, const std::shared_ptr< Tile > &, int32_t )
+		{
+			++tileHits;
+		}
+
+		uint64_t tileHits;
+	};
+	struct CollisionResult
+	{
+		CollisionResult()
+			:	seconds( 0.0 )
+			,	tileHits( 0 )
+			,	positionSum( 0.0 )
+		{
+		}
+		double seconds;
+		uint64_t tileHits;
+		double positionSum;
+	};
+
+	BenchmarkBoard::BenchmarkBoard()
+		:	windowSize( ViewTransform::GetField() )
+		,	tickLength( 0.01 )
+		,	config()
+		,	netManager()
+		,	messageSender( netManager )
+		,	physicsManager( messageSender )
+		,	localPaddle( std::make_shared< Paddle >() )
+		,	remotePaddle( std::make_shared< Paddle >() )
+		,	localPlayerInfo()
+		,	remotePlayerInfo()
+		,	gameRules( physicsManager, config, localPlayerInfo, remotePlayerInfo )
+		,	levelName()
+	{
+		config.LoadConfig();
+
+		localPlayerInfo.Reset();
+		remotePlayerInfo.Reset();
+	}
+	bool BenchmarkBoard::Load( const std::string &board )
+	{
+		BoardLoader boardLoader;
+		if ( board.empty() && boardLoader.IsLastLevel() )
+		{
+			std::cout << "No boards to play, check boards/boardlist.txt" << std::endl;
+			return false;
+		}
+
+		Board level = board.empty() ? boardLoader.GenerateBoard( windowSize ) : boardLoader.GenerateBoard( board, windowSize );
+
+		physicsManager.SetWindowSize( windowSize );
+		physicsManager.SetPaddles( localPaddle, remotePaddle );
+		physicsManager.SetPaddleData();
+		physicsManager.SetAIPaddleSpeed( config.Get( ConfigValueType::AIPaddleSpeed ) );
+
+		for ( const auto &tile : level.GetTiles() )
+			physicsManager.CreateTile( tile.tilePos, tile.type, -1 );
+
+		physicsManager.UpdateScale();
+
+		gameRules.SetWindowSize( windowSize );
+		gameRules.SetPaddles( localPaddle, remotePaddle );
+		gameRules.SetPlaysBothPlayers( true );
+		gameRules.SetIndestructible( true );
+
+		levelName = level.levelName;
+		return true;
+	}
+	void BenchmarkBoard::MovePaddles()
+	{
+		physicsManager.AIMove( Player::Local, tickLength );
+		physicsManager.AIMove( Player::Remote, tickLength );
+	}
+	// The way GameManager::UpdateBalls used to do it : the bonus is looked up for every tile hit
+	uint64_t UpdateBallCollision( BenchmarkBoard &arena, const std::shared_ptr< Ball > &ball, bool isSuperBall )
+	{
+		const auto &paddle = ( ball->GetOwner() == Player::Local ) ? arena.localPaddle : arena.remotePaddle;
+
+		if ( ball->BoundCheck( arena.windowSize ) || ball->PaddleCheck( paddle->rect ) )
+			return 0;
+
+		uint64_t hits = 0;
+		std::shared_ptr< Tile > tile = arena.physicsManager.FindClosestIntersectingTile( ball );
+
+		if ( tile && ball->TileCheck( tile->rect, isSuperBall ) )
+		{
+			// The tiles are never removed, a normal ball backs out so it isn't stuck in one
+			if ( !isSuperBall )
+			{
+				ball->rect.x = ball->oldRect.x;
+				ball->rect.y = ball->oldRect.y;
+			}
+
+			++hits;
+		}
+
+		ball->DeathCheck( arena.windowSize );
+
+		return hits;
+	}
+	bool RunCollisionPass(
+		uint32_t frameCount,
+		uint32_t ballCount,
+		const std::string &board,
+		bool isSuperBall,
+		bool isTemplated,
+		CollisionResult &result
+	)
+	{
+		RandomService::Current().Seed( 1 );
+
+		BenchmarkBoard arena;
+
+		if ( !arena.Load( board ) )
+			return false;
+
+		arena.localPlayerInfo.SetBonusActive( BonusType::SuperBall, isSuperBall );
+		arena.remotePlayerInfo.SetBonusActive( BonusType::SuperBall, isSuperBall );
+
+		TileHitCounter counter;
+		arena.gameRules.SetListener( &counter );
+
+		std::vector< std::shared_ptr< Ball > > ballList;
+
+		for ( uint32_t i = 0; i < ballCount; ++i )
+		{
+			Player owner = ( i % 2 == 0 ) ? Player::Local : Player::Remote;
+			ballList.push_back( arena.physicsManager.CreateBall( owner, i + 1, arena.config.Get( ConfigValueType::BallSpeed ) ) );
+		}
+
+		result = CollisionResult();
+
+		for ( uint32_t frame = 0; frame < frameCount; ++frame )
+		{
+			arena.MovePaddles();
+
+			auto start = std::chrono::steady_clock::now();
+
+			if ( !isTemplated )
+			{
+				for ( const auto &ball : ballList )
+				{
+					ball->Update( arena.tickLength );
+
+					const PlayerInfo &info = arena.gameRules.GetPlayerInfo( ball->GetOwner() );
+					result.tileHits += UpdateBallCollision( arena, ball, info.IsBonusActive( BonusType::SuperBall ) );
+				}
+			}
+			// The way it does it now : GameRules picks a templated loop once per frame
+			else
+				arena.gameRules.UpdateBalls( ballList, arena.tickLength );
+
+			std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+			result.seconds += elapsed.count();
+		}
+
+		if ( isTemplated )
+			result.tileHits = counter.tileHits;
+
+		for ( const auto &ball : ballList )
+			result.positionSum += ball->rect.x + ball->rect.y;
+
+		arena.gameRules.SetListener( nullptr );
+
+		return true;
+	}
+}
+bool Benchmark::Run( const std::string &name, uint32_t count, const std::string &board )
+{
+	if ( name == "parser" )
+		RunMessageParsing( count > 0 ? count : 1000000 );
+	else if ( name == "random" )
+		RunRandom( count > 0 ? count : 1000000 );
+	else if ( name == "ballstorm" )
+		return RunBallStorm( count > 0 ? count : 100000, board );
+	else if ( name == "collision" )
+		return RunCollision( count > 0 ? count : 2000, board );
+	else if ( name == "boardgen" )
+		return RunBoardGeneration( count > 0 ? count : 100000, board );
+	else
+	{
+		std::cout << "Unknown benchmark : " << name << std::endl;
+		std::cout << "Valid benchmarks : parser, random, ballstorm, collision, boardgen" << std::endl;
+		return false;
+	}
+
+	return true;
+}
+void Benchmark::RunMessageParsing( uint32_t messageCount )
+{
+	// A mix of the messages sent most often during a game
+	std::vector< TCPMessage > messages( 6 );
+
+	messages[0].SetMessageType( MessageType::PaddlePosition );
+	messages[0].SetPos1( LogicalPosition::FromField( Vector2f( 862.5, 0.0 ) ) );
+
+	messages[1].SetMessageType( MessageType::BallData );
+	messages[1].SetObjectID( 12 );
+	messages[1].SetPos1( LogicalPosition::FromField( Vector2f( 635.0922, 240.5 ) ) );
+	messages[1].SetDir( Vector2f( 0.7071067, -0.7071067 ) );
+	messages[1].SetTimeStamp( 1234567 );
+
+	messages[2].SetMessageType( MessageType::TileHit );
+	messages[2].SetObjectID( 140 );
+	messages[2].SetTileKilled( true );
+
+	messages[3].SetMessageType( MessageType::BulletFire );
+	messages[3].SetObjectID( 7 );
+	messages[3].SetObjectID2( 8 );
+	messages[3].SetPos1( LogicalPosition::FromField( Vector2f( 800.0, 1020.0 ) ) );
+	messages[3].SetPos2( LogicalPosition::FromField( Vector2f( 920.0, 1020.0 ) ) );
+
+	messages[4].SetMessageType( MessageType::PlayerName );
+	messages[4].SetPlayerName( "A_player_with_a_long_name" );
+
+	messages[5].SetMessageType( MessageType::BallKilled );
+	messages[5].SetObjectID( 12 );
+
+	// Roughly what a busy frame would recieve in one read
+	const uint32_t messagesPerBuffer = 600;
+
+	std::stringstream bufferStream;
+	for ( uint32_t i = 0; i < messagesPerBuffer; ++i )
+		bufferStream << messages[ i % messages.size() ];
+
+	const std::string buffer = bufferStream.str();
+	uint32_t bufferCount = ( messageCount + messagesPerBuffer - 1 ) / messagesPerBuffer;
+	uint64_t parsed = 0;
+
+	std::cout << "Parsing " << static_cast< uint64_t > ( bufferCount ) * messagesPerBuffer
+		<< " messages, " << buffer.size() << " bytes per read" << std::endl;
+
+	// Old path : copy into a stringstream and use operator>>
+	auto start = std::chrono::steady_clock::now();
+	{
+		TCPMessage msg;
+		for ( uint32_t i = 0; i < bufferCount; ++i )
+		{
+			std::stringstream ss;
+			ss << buffer;
+
+			while ( ss >> msg )
+				++parsed;
+		}
+	}
+	std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+	PrintResult( "stringstream", parsed, elapsed.count() );
+
+	// New path : read straight from the buffer into a reused message
+	parsed = 0;
+	start = std::chrono::steady_clock::now();
+	{
+		TCPMessage msg;
+		TCPMessageParser parser;
+		for ( uint32_t i = 0; i < bufferCount; ++i )
+		{
+			parser.SetBuffer( buffer.data(), buffer.size() );
+
+			while ( parser.ParseNext( msg ) )
+				++parsed;
+		}
+	}
+	elapsed = std::chrono::steady_clock::now() - start;
+	PrintResult( "parser", parsed, elapsed.count() );
+}
+void Benchmark::RunRandom( uint32_t count )
+{
+	double sum = 0.0;
+
+	std::cout << "Generating " << count << " random numbers" << std::endl;
+
+	// Old path : a new std::mt19937 seeded from std::random_device for every number
+	auto start = std::chrono::steady_clock::now();
+	for ( uint32_t i = 0; i < count; ++i )
+	{
+		std::random_device rseed;
+		std::mt19937 rgen( rseed() );
+		std::uniform_real_distribution< double > rdist( -1.0, 1.0 );
+
+		sum += rdist( rgen );
+	}
+	std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+	PrintResult( "mt19937", count, elapsed.count() );
+
+	// New path : one number at a time from a stream
+	RandomGenerator &random = RandomService::Get( RandomStream::Gameplay );
+
+	start = std::chrono::steady_clock::now();
+	for ( uint32_t i = 0; i < count; ++i )
+		sum += random.GenRandomNumber( -1.0, 1.0 );
+	elapsed = std::chrono::steady_clock::now() - start;
+	PrintResult( "generator", count, elapsed.count() );
+
+	// Batch, the way particles are generated
+	std::vector< double > values( 1024 );
+
+	start = std::chrono::steady_clock::now();
+	for ( uint32_t i = 0; i < count; i += static_cast< uint32_t > ( values.size() ) )
+	{
+		random.Fill( &values[ 0 ], values.size(), -1.0, 1.0 );
+		sum += values[ 0 ];
+	}
+	elapsed = std::chrono::steady_clock::now() - start;
+	PrintResult( "fill", count, elapsed.count() );
+
+	// Keeps the compiler from removing the loops
+	std::cout << "Checksum : " << sum << std::endl;
+}
+bool Benchmark::RunBallStorm( uint32_t maxBalls, const std::string &board )
+{
+	BenchmarkBoard arena;
+
+	if ( !arena.Load( board ) )
+		return false;
+
+	PhysicsManager &physicsManager = arena.physicsManager;
+
+	std::cout << "Ball storm on " << arena.levelName << ", " << physicsManager.CountAllTiles() << " tiles, up to " << maxBalls << " balls" << std::endl;
+
+	BallStorm storm;
+	storm.Start( maxBalls, 200 );
+
+	std::vector< std::shared_ptr< Ball > > ballList;
+	uint32_t ballID = 0;
+
+	while ( storm.IsRunning() )
+	{
+		// Half the balls for each player, so both paddles and both ends of the board are used
+		while ( ballList.size() < storm.GetBallCount() )
+		{
+			Player owner = ( ballID % 2 == 0 ) ? Player::Local : Player::Remote;
+			ballList.push_back( physicsManager.CreateBall( owner, ++ballID, arena.config.Get( ConfigValueType::BallSpeed ) ) );
+		}
+
+		physicsManager.ResetCollisionTestCount();
+
+		// The same GameRules as a game, except the board is indestructible ( see BenchmarkBoard )
+		auto start = std::chrono::steady_clock::now();
+
+		arena.MovePaddles();
+		arena.gameRules.UpdateBalls( ballList, arena.tickLength );
+
+		std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+
+		// Nothing is rendered
+		storm.AddFrame( elapsed.count(), 0.0, physicsManager.GetCollisionTestCount() );
+	}
+
+	storm.WriteCSV( std::cout );
+	return storm.WriteCSV( "ballstorm.csv" );
+}
+bool Benchmark::RunCollision( uint32_t frameCount, const std::string &board )
+{
+	const uint32_t ballCount = 1000;
+
+	std::cout << "Ball / tile collisions, " << ballCount << " balls, " << frameCount << " frames" << std::endl;
+
+	for ( bool isSuperBall : { false, true } )
+	{
+		// Both passes play out the same, so the hit counts should match
+		CollisionResult branched;
+		CollisionResult templated;
+
+		if ( !RunCollisionPass( frameCount, ballCount, board, isSuperBall, false, branched ) )
+			return false;
+
+		if ( !RunCollisionPass( frameCount, ballCount, board, isSuperBall, true, templated ) )
+			return false;
+
+		std::string name = isSuperBall ? "super" : "normal";
+
+		PrintResult( name + "/branch", branched.tileHits, branched.seconds );
+		PrintResult( name + "/template", templated.tileHits, templated.seconds );
+
+		if ( branched.tileHits != templated.tileHits || branched.positionSum != templated.positionSum )
+			std::cout << "The two passes don't agree, the results can't be compared" << std::endl;
+	}
+
+	return true;
+}
+bool Benchmark::RunBoardGeneration( uint32_t tileCount, const std::string &board )
+{
+	BoardGeneratorSettings settings;
+
+	if ( !board.empty() && !BoardGenerator::ParseName( board, settings ) )
+	{
+		std::cout << "Not a board generator name : " << board << std::endl;
+		return false;
+	}
+
+	settings.tileCount = tileCount;
+
+	// A new seed for every board, so it's not the same cells that are picked every time
+	const uint32_t boardCount = 10;
+	const uint64_t firstSeed = settings.seed;
+
+	std::cout << "Generating " << boardCount << " boards of " << tileCount << " tiles" << std::endl;
+
+	Board last;
+	auto start = std::chrono::steady_clock::now();
+	for ( uint32_t i = 0; i < boardCount; ++i )
+	{
+		settings.seed = firstSeed + i;
+		last = BoardGenerator::Generate( settings );
+	}
+	std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+	PrintResult( "generate", static_cast< uint64_t > ( boardCount ) * tileCount, elapsed.count() );
+
+	std::cout << "Per board : " << ( elapsed.count() * 1000.0 / boardCount ) << " ms" << std::endl;
+
+	// The mix of the last board, to compare with the weights
+	uint64_t typeCount[ 4 ] = { 0, 0, 0, 0 };
+	for ( const auto &tile : last.GetTiles() )
+		++typeCount[ static_cast< size_t > ( tile.type ) ];
+
+	std::cout << "Regular : " << typeCount[0] << " Explosive : " << typeCount[1]
+		<< " Hard : " << typeCount[2] << " Unbreakable : " << typeCount[3] << std::endl;
+
+	return true;
+}
+void Benchmark::PrintResult( const std::string &name, uint64_t itemCount, double seconds )
+{
+	double perSecond = ( seconds > 0.0 ) ? ( static_cast< double > ( itemCount ) / seconds ) : 0.0;
+
+	std::cout
+		<< std::left << std::setw( 14 ) << name
+		<< " | count : " << std::setw( 10 ) << itemCount
+		<< " | seconds : " << std::setw( 10 ) << seconds
+		<< " | per second : " << std::fixed << std::setprecision( 0 ) << perSecond
+		<< std::defaultfloat << std::setprecision( 6 ) << std::endl;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+// Stand alone performance measurements, started with the -benchmark command line option
+class Benchmark
+{
+	public:
+	// board is used by ballstorm and collision, the first board in boards/boardlist.txt if it's empty
+	// It can be a BoardGenerator name too, like "generate:tiles=100000,density=0.5"
+	static bool Run( const std::string &name, uint32_t count, const std::string &board );
+
+	// Compares parsing TCPMessages through std::stringstream with TCPMessageParser
+	static void RunMessageParsing( uint32_t messageCount );
+
+	// Compares constructing a std::mt19937 for every number with RandomService
+	static void RunRandom( uint32_t count );
+
+	// Headless BallStorm, up to maxBalls balls bouncing around on board. The tiles are never destroyed, so every step plays on the same board
+	// Prints the CSV, and writes it to ballstorm.csv
+	static bool RunBallStorm( uint32_t maxBalls, const std::string &board );
+
+	// Compares looking up SuperBall for every ball ( a branch per tile hit ) with GameRules, which picks a templated loop once per frame
+	// Both players' balls hit tiles, the tiles are never destroyed. Runs with SuperBall off, then on
+	static bool RunCollision( uint32_t frameCount, const std::string &board );
+
+	// Generates ten boards of tileCount tiles. board can be a BoardGenerator name, for the other settings
+	static bool RunBoardGeneration( uint32_t tileCount, const std::string &board );
+
+	private:
+	static void PrintResult( const std::string &name, uint64_t itemCount, double seconds );
+};
@@ -0,0 +1,165 @@
+#include "ConfigWatcher.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#if defined( __linux__ )
+	#include <poll.h>
+	#include <unistd.h>
+	#include <sys/inotify.h>
+#endif
+
+ConfigWatcher::ConfigWatcher()
+	:	thread()
+	,	isRunning( false )
+	,	mutex()
+	,	hasChanges( false )
+	,	pending()
+	,	inotifyFD( -1 )
+	,	configWatch( -1 )
+	,	boardsWatch( -1 )
+{
+}
+ConfigWatcher::~ConfigWatcher()
+{
+	Stop();
+}
+bool ConfigWatcher::Start()
+{
+#if defined( __linux__ )
+	if ( isRunning )
+		return true;
+
+	inotifyFD = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+
+	if ( inotifyFD < 0 )
+		return false;
+
+	// Editors either write the file in place, or write a new one and move it over the old one
+	const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO;
+
+	configWatch = inotify_add_watch( inotifyFD, "config", mask );
+	boardsWatch = inotify_add_watch( inotifyFD, "boards", mask );
+
+	if ( configWatch < 0 && boardsWatch < 0 )
+	{
+		close( inotifyFD );
+		inotifyFD = -1;
+		return false;
+	}
+
+	isRunning = true;
+	thread = std::thread( &ConfigWatcher::Run, this );
+
+	return true;
+#else
+	return false;
+#endif
+}
+void ConfigWatcher::Stop()
+{
+	if ( !isRunning )
+		return;
+
+	isRunning = false;
+	thread.join();
+
+#if defined( __linux__ )
+	close( inotifyFD );
+	inotifyFD = -1;
+#endif
+}
+bool ConfigWatcher::TakeChanges( ConfigChanges &changes )
+{
+	if ( !hasChanges )
+		return false;
+
+	std::lock_guard< std::mutex > lock( mutex );
+
+	std::swap( pending, changes );
+	pending.Clear();
+	hasChanges = false;
+
+	return true;
+}
+#if defined( __linux__ )
+void ConfigWatcher::Run()
+{
+	while ( isRunning )
+	{
+		pollfd fd = { inotifyFD, POLLIN, 0 };
+
+		// Wakes up now and then to see if it should stop
+		if ( poll( &fd, 1, 100 ) <= 0 )
+			continue;
+
+		bool configChanged = false;
+		bool colorsChanged = false;
+		bool boardsChanged = false;
+
+		// Saving can mean several events in a row, those are handled as one change
+		ReadEvents( configChanged, colorsChanged, boardsChanged );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+		ReadEvents( configChanged, colorsChanged, boardsChanged );
+
+		// Parsed before locking, so the game thread never waits for the files
+		// Nothing is printed here, the game thread prints the new values when it takes them
+		ConfigLoader config;
+		if ( configChanged )
+			config.ReadConfig();
+
+		ColorConfigLoader colors;
+		if ( colorsChanged )
+			colors.LoadConfig();
+
+		std::lock_guard< std::mutex > lock( mutex );
+
+		if ( configChanged )
+		{
+			pending.config = std::move( config );
+			pending.hasConfig = true;
+		}
+
+		if ( colorsChanged )
+		{
+			pending.colors = std::move( colors );
+			pending.hasColors = true;
+		}
+
+		pending.hasBoards = pending.hasBoards || boardsChanged;
+
+		hasChanges = pending.hasConfig || pending.hasColors || pending.hasBoards;
+	}
+}
+void ConfigWatcher::ReadEvents( bool &configChanged, bool &colorsChanged, bool &boardsChanged )
+{
+	char buffer[ 4096 ];
+	ssize_t length = 0;
+
+	while ( ( length = read( inotifyFD, buffer, sizeof( buffer ) ) ) > 0 )
+	{
+		ssize_t offset = 0;
+
+		while ( offset < length )
+		{
+			// The events in the buffer aren't aligned
+			inotify_event event;
+			std::memcpy( &event, buffer + offset, sizeof( event ) );
+
+			const char* namePtr = buffer + offset + sizeof( event );
+			std::string name( namePtr, strnlen( namePtr, event.len ) );
+
+			if ( event.wd == configWatch && name == "Config.txt" )
+				configChanged = true;
+			else if ( event.wd == configWatch && name == "ColorCfg.txt" )
+				colorsChanged = true;
+			else if ( event.wd == boardsWatch )
+				boardsChanged = true;
+
+			offset += static_cast< ssize_t > ( sizeof( event ) + event.len );
+		}
+	}
+}
+#endif
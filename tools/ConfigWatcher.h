@@ -0,0 +1,73 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+
+#include "ConfigLoader.h"
+#include "ColorConfigLoader.h"
+
+// What has changed on disk since the last frame. The files are already parsed, so applying it is cheap
+struct ConfigChanges
+{
+	ConfigChanges()
+		:	hasConfig( false )
+		,	config()
+		,	hasColors( false )
+		,	colors()
+		,	hasBoards( false )
+	{
+	}
+	void Clear()
+	{
+		hasConfig = false;
+		hasColors = false;
+		hasBoards = false;
+	}
+
+	// config/Config.txt
+	bool hasConfig;
+	ConfigLoader config;
+
+	// config/ColorCfg.txt
+	bool hasColors;
+	ColorConfigLoader colors;
+
+	// boards/boardlist.txt, or one of the boards. Boards are read when they're played, so there's nothing to parse here
+	bool hasBoards;
+};
+
+// Watches config/ and boards/ on its own thread, and parses the files that are changed there
+// The game takes the changes between two frames ( see GameManager::ApplyConfigChanges ), so a frame never sees half of a change
+// Uses inotify, so it only works on Linux. Elsewhere Start just returns false
+class ConfigWatcher
+{
+	public:
+		ConfigWatcher();
+		~ConfigWatcher();
+
+		bool Start();
+		void Stop();
+
+		// Game thread. Returns false without locking anything if nothing has changed
+		bool TakeChanges( ConfigChanges &changes );
+
+	private:
+		void Run();
+		// Reads all the waiting events, and sets the flags for the files they're about
+		void ReadEvents( bool &configChanged, bool &colorsChanged, bool &boardsChanged );
+
+		std::thread thread;
+		std::atomic< bool > isRunning;
+
+		std::mutex mutex;
+		std::atomic< bool > hasChanges;
+		ConfigChanges pending;
+
+		int inotifyFD;
+		int configWatch;
+		int boardsWatch;
+
+		ConfigWatcher( const ConfigWatcher &other );
+		ConfigWatcher& operator=( const ConfigWatcher &other );
+};
@@ -0,0 +1,172 @@
+#include "RenderThread.h"
+
+#include <chrono>
+#include <utility>
+
+RenderThread::State::State()
+	:	mutex()
+	,	wakeRenderer()
+	,	jobDone()
+	,	renderThreadID()
+	,	isRunning( false )
+	,	isFinished( false )
+	,	jobs()
+	,	latest()
+	,	hasNewFrame( false )
+	,	deadTextures()
+{
+}
+void RenderThread::Start()
+{
+	State &state = GetState();
+	std::lock_guard< std::mutex > lock( state.mutex );
+
+	state.renderThreadID = std::this_thread::get_id();
+	state.isRunning = true;
+	state.isFinished = false;
+}
+void RenderThread::Stop()
+{
+	State &state = GetState();
+	std::lock_guard< std::mutex > lock( state.mutex );
+
+	state.isRunning = false;
+
+	// Nothing will draw these frames now
+	DestroyTextures( state.latest.deadTextures );
+	DestroyTextures( state.deadTextures );
+
+	state.latest.Clear();
+	state.hasNewFrame = false;
+}
+bool RenderThread::IsRunning()
+{
+	State &state = GetState();
+	std::lock_guard< std::mutex > lock( state.mutex );
+
+	return state.isRunning;
+}
+void RenderThread::Invoke( const std::function< void() > &job )
+{
+	State &state = GetState();
+	std::unique_lock< std::mutex > lock( state.mutex );
+
+	if ( !state.isRunning || state.renderThreadID == std::this_thread::get_id() )
+	{
+		lock.unlock();
+		job();
+		return;
+	}
+
+	Job waitingJob = { &job, false };
+	state.jobs.push_back( &waitingJob );
+	state.wakeRenderer.notify_one();
+
+	state.jobDone.wait( lock, [ &waitingJob ](){ return waitingJob.done; } );
+}
+void RenderThread::DestroyTexture( SDL_Texture* texture )
+{
+	if ( texture == nullptr )
+		return;
+
+	State &state = GetState();
+	std::unique_lock< std::mutex > lock( state.mutex );
+
+	if ( state.isRunning )
+	{
+		state.deadTextures.push_back( texture );
+		return;
+	}
+
+	lock.unlock();
+	SDL_DestroyTexture( texture );
+}
+void RenderThread::Publish( RenderFrame &frame )
+{
+	State &state = GetState();
+	std::lock_guard< std::mutex > lock( state.mutex );
+
+	frame.deadTextures.insert( frame.deadTextures.end(), state.deadTextures.begin(), state.deadTextures.end() );
+	state.deadTextures.clear();
+
+	// The last frame was never drawn. Its render target updates and dead textures are moved into this one, the rest is dropped
+	if ( state.hasNewFrame )
+	{
+		state.latest.targetUpdates.Append( frame.targetUpdates );
+		std::swap( state.latest.targetUpdates, frame.targetUpdates );
+
+		frame.deadTextures.insert( frame.deadTextures.end(), state.latest.deadTextures.begin(), state.latest.deadTextures.end() );
+		state.latest.deadTextures.clear();
+	}
+
+	std::swap( state.latest, frame );
+	state.hasNewFrame = true;
+
+	state.wakeRenderer.notify_one();
+}
+void RenderThread::Finish()
+{
+	State &state = GetState();
+	std::lock_guard< std::mutex > lock( state.mutex );
+
+	state.isFinished = true;
+	state.wakeRenderer.notify_one();
+}
+bool RenderThread::WaitForFrame( RenderFrame &frame, uint32_t timeout )
+{
+	State &state = GetState();
+	std::unique_lock< std::mutex > lock( state.mutex );
+
+	RunJobs( state, lock );
+
+	state.wakeRenderer.wait_for(
+		lock,
+		std::chrono::milliseconds( timeout ),
+		[ &state ](){ return state.hasNewFrame || state.isFinished || !state.jobs.empty(); }
+	);
+
+	RunJobs( state, lock );
+
+	if ( !state.hasNewFrame )
+		return false;
+
+	std::swap( state.latest, frame );
+	state.hasNewFrame = false;
+
+	return true;
+}
+bool RenderThread::IsFinished()
+{
+	State &state = GetState();
+	std::lock_guard< std::mutex > lock( state.mutex );
+
+	return state.isFinished;
+}
+RenderThread::State& RenderThread::GetState()
+{
+	static State state;
+	return state;
+}
+void RenderThread::RunJobs( State &state, std::unique_lock< std::mutex > &lock )
+{
+	while ( !state.jobs.empty() )
+	{
+		Job* job = state.jobs.front();
+		state.jobs.pop_front();
+
+		// The job can take a while, like rendering text, the game thread might want to publish a frame meanwhile
+		lock.unlock();
+		( *job->job )();
+		lock.lock();
+
+		job->done = true;
+		state.jobDone.notify_all();
+	}
+}
+void RenderThread::DestroyTextures( std::vector< SDL_Texture* > &textures )
+{
+	for ( auto texture : textures )
+		SDL_DestroyTexture( texture );
+
+	textures.clear();
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <mutex>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+#include <SDL2/SDL.h>
+
+#include "structs/rendering/RenderFrame.h"
+
+// Lets the game run on its own thread, so that waiting for SDL_RenderPresent ( and vsync ) doesn't hold up physics, input and the network
+// SDL only allows the thread that created the renderer to use it, so that thread stays the render thread, and only draws
+//
+// The game records every frame ( see Renderer::Render ) and publishes it here. The render thread always takes the latest one,
+// frames it didn't get to in time are skipped. Three RenderFrames are passed around, so recording doesn't allocate
+//
+// Textures still have to be created and destroyed on the render thread. The RenderHelpers do that through Invoke and DestroyTexture
+// Until Start is called, and after Stop, everything just happens on the calling thread
+class RenderThread
+{
+	public:
+		// Called by the thread that owns the renderer
+		static void Start();
+		// Destroys the textures that were waiting for a frame to be drawn
+		static void Stop();
+		static bool IsRunning();
+
+		// Runs job on the render thread and waits for it to finish
+		static void Invoke( const std::function< void() > &job );
+		// Frames that have already been published might still use the texture, so it's destroyed after the next one has been drawn
+		static void DestroyTexture( SDL_Texture* texture );
+
+		// Game thread
+		// Swaps frame with the latest one, frame can then be cleared and recorded into again
+		static void Publish( RenderFrame &frame );
+		// No more frames are coming, the render thread can stop
+		static void Finish();
+
+		// Render thread
+		// Runs the jobs waiting in Invoke, then waits up to timeout ms for a new frame. Returns false if there wasn't one
+		static bool WaitForFrame( RenderFrame &frame, uint32_t timeout );
+		static bool IsFinished();
+
+	private:
+		struct Job
+		{
+			const std::function< void() >* job;
+			bool done;
+		};
+
+		struct State
+		{
+			State();
+
+			std::mutex mutex;
+			std::condition_variable wakeRenderer;
+			std::condition_variable jobDone;
+
+			std::thread::id renderThreadID;
+			bool isRunning;
+			bool isFinished;
+
+			std::deque< Job* > jobs;
+
+			RenderFrame latest;
+			bool hasNewFrame;
+
+			std::vector< SDL_Texture* > deadTextures;
+		};
+
+		static State& GetState();
+		static void RunJobs( State &state, std::unique_lock< std::mutex > &lock );
+		static void DestroyTextures( std::vector< SDL_Texture* > &textures );
+};
@@ -3,6 +3,11 @@
 #include <iostream>
 #include "../structs/rendering/RenderingItem.h"
 #include "../structs/rendering/Particle.h"
+#include "../structs/rendering/DrawList.h"
+#include "../structs/rendering/GlyphAtlas.h"
+
+#include "RenderThread.h"
+#include "../math/ViewTransform.h"
 
 #include "../structs/menu_items/MainMenuItem.h"
 #include "../structs/menu_items/ConfigItem.h"
@@ -49,11 +54,15 @@ SDL_Texture* RenderHelpers::InitSurface( int width, int height, unsigned char r,
 
 	FillSurface( surface, r, g, b );
 
-	SDL_Texture* texture = SDL_CreateTextureFromSurface( renderer, surface );
+	SDL_Texture* texture = CreateTexture( renderer, surface );
 	SDL_FreeSurface( surface );
 
 	return texture;
 }
+SDL_Surface* RenderHelpers::CreateRGBASurface( int width, int height )
+{
+	return SDL_CreateRGBSurface( 0, width, height, SCREEN_BPP, R_MASK, G_MASK, B_MASK, A_MASK );
+}
 void RenderHelpers::FillSurface( SDL_Surface* source, unsigned char r, unsigned char g, unsigned char b )
 {
 	SDL_FillRect( source, NULL, SDL_MapRGBA( source->format, r, g, b, 255 )  );
@@ -84,7 +93,7 @@ SDL_Texture* RenderHelpers::RenderTextTexture_Solid(
 		rect.w = surface->clip_rect.w;
 		rect.h = surface->clip_rect.h;
 
-		SDL_Texture* texture = SDL_CreateTextureFromSurface( renderer, surface );
+		SDL_Texture* texture = CreateTexture( renderer, surface );
 
 		SDL_FreeSurface( surface );
 
@@ -118,7 +127,7 @@ SDL_Texture* RenderHelpers::RenderTextTexture_Blended(
 		rect.w = surface->clip_rect.w;
 		rect.h = surface->clip_rect.h;
 
-		SDL_Texture* texture = SDL_CreateTextureFromSurface( renderer, surface );
+		SDL_Texture* texture = CreateTexture( renderer, surface );
 
 		SDL_FreeSurface( surface );
 
@@ -138,52 +147,69 @@ void RenderHelpers::SetDrawColor( SDL_Renderer* renderer, const SDL_Color &clr )
 {
 	SDL_SetRenderDrawColor( renderer, clr.r, clr.g, clr.b, clr.a);
 }
-void RenderHelpers::RenderTextItem( SDL_Renderer* renderer,  const RenderingItem< std::string >  &item )
+void RenderHelpers::SetDrawColor( DrawList &drawList, const SDL_Color &clr )
+{
+	drawList.SetDrawColor( clr );
+}
+SDL_Texture* RenderHelpers::CreateTexture( SDL_Renderer* renderer, SDL_Surface* surface )
+{
+	SDL_Texture* texture = nullptr;
+
+	// The surface is made on the calling thread, only uploading it has to wait for the render thread
+	RenderThread::Invoke( [ & ](){ texture = SDL_CreateTextureFromSurface( renderer, surface ); } );
+
+	return texture;
+}
+void RenderHelpers::DestroyTexture( SDL_Texture* texture )
+{
+	RenderThread::DestroyTexture( texture );
+}
+void RenderHelpers::RenderTextItem( DrawList &drawList,  const RenderingItem< std::string >  &item )
 {
 	if ( item.texture != nullptr  )
-		SDL_RenderCopy( renderer, item.texture, nullptr, &item.rect );
+		drawList.Copy( item.texture, nullptr, item.rect, { 255, 255, 255, item.textureAlpha } );
 }
-void RenderHelpers::RenderTextItem( SDL_Renderer* renderer, const RenderingItem< uint64_t >  &item )
+void RenderHelpers::RenderTextItem( DrawList &drawList, const RenderingItem< uint64_t >  &item )
 {
 	if ( item.texture != nullptr  )
-		SDL_RenderCopy( renderer, item.texture, nullptr, &item.rect );
+		drawList.Copy( item.texture, nullptr, item.rect, { 255, 255, 255, item.textureAlpha } );
 }
-void RenderHelpers::RenderMenuItem( SDL_Renderer* renderer, const std::shared_ptr< MenuItem > &item )
+void RenderHelpers::RenderMenuItem( DrawList &drawList, const std::shared_ptr< MenuItem > &item )
 {
 	if( item->GetTexture() != nullptr )
-		SDL_RenderCopy( renderer, item->GetTexture(), nullptr, item->GetRectPtr() );
+		drawList.Copy( item->GetTexture(), nullptr, item->GetTextureRect() );
 }
-void RenderHelpers::RenderConfigItem( SDL_Renderer* renderer, const std::shared_ptr< ConfigItem > &item )
+void RenderHelpers::RenderConfigItem( DrawList &drawList, const std::shared_ptr< ConfigItem > &item, const GlyphAtlas &valueAtlas, const SDL_Color &valueColor )
 {
-	RenderMenuItem( renderer, item );
+	RenderMenuItem( drawList, item );
 
 	if ( item->IsBool() )
 	{
 		if ( item->GetBool() )
-			SDL_SetRenderDrawColor( renderer, 0,255,0,255 );
+			drawList.SetDrawColor( { 0, 255, 0, 255 } );
 		else
-			SDL_SetRenderDrawColor( renderer, 255,0,0,255 );
-		SDL_RenderFillRect( renderer, item->GetValueRectPtr() );
+			drawList.SetDrawColor( { 255, 0, 0, 255 } );
+		drawList.FillRect( *item->GetValueRectPtr() );
 	}
 	else
 	{
-		RenderPluss( renderer, item->GetPlussRect() );
-		RenderMinus( renderer, item->GetMinusRect() );
+		RenderPluss( drawList, item->GetPlussRect() );
+		RenderMinus( drawList, item->GetMinusRect() );
 	}
 
-	if( item->GetValueTexture() != nullptr )
-		SDL_RenderCopy( renderer, item->GetValueTexture(), nullptr, item->GetValueRectPtr() );
+	SDL_Rect valueRect = item->GetValueRect();
+	valueAtlas.Render( drawList, item->GetValueText(), valueRect.x, valueRect.y, valueColor );
 }
-void RenderHelpers::RenderMinus( SDL_Renderer* renderer, SDL_Rect square )
+void RenderHelpers::RenderMinus( DrawList &drawList, SDL_Rect square )
 {
 	SDL_Rect minus = square;
 	minus .h /= 3;
 	minus .y += ( square.h / 2 ) - ( minus .h / 2 );
 
-	SDL_SetRenderDrawColor( renderer, 255,0,0,255 );
-	SDL_RenderFillRect( renderer, &minus );
+	drawList.SetDrawColor( { 255, 0, 0, 255 } );
+	drawList.FillRect( minus );
 }
-void RenderHelpers::RenderPluss( SDL_Renderer* renderer, SDL_Rect square )
+void RenderHelpers::RenderPluss( DrawList &drawList, SDL_Rect square )
 {
 	SDL_Rect horizontalLine = square;
 	horizontalLine .w /= 3;
@@ -193,11 +219,11 @@ void RenderHelpers::RenderPluss( SDL_Renderer* renderer, SDL_Rect square )
 	verticalLine.h /= 3;
 	verticalLine.y += ( square.h / 2 ) - ( verticalLine.h / 2 );
 
-	SDL_SetRenderDrawColor( renderer, 0,255,0,255 );
-	SDL_RenderFillRect( renderer, &horizontalLine );
-	SDL_RenderFillRect( renderer, &verticalLine );
+	drawList.SetDrawColor( { 0, 255, 0, 255 } );
+	drawList.FillRect( horizontalLine );
+	drawList.FillRect( verticalLine );
 }
-void RenderHelpers::RenderPlussMinus ( SDL_Renderer* renderer, SDL_Rect origin )
+void RenderHelpers::RenderPlussMinus ( DrawList &drawList, SDL_Rect origin )
 {
 	SDL_Rect square = origin;
 	square.w = 15;
@@ -206,56 +232,56 @@ void RenderHelpers::RenderPlussMinus ( SDL_Renderer* renderer, SDL_Rect origin )
 	square.x += ( origin.w /2 ) - ( square.w / 2 );
 	square.y -= square.h - 5;
 
-	RenderPluss( renderer, square );
+	RenderPluss( drawList, square );
 	square.y = origin.y + origin.h - 5;
-	RenderMinus( renderer, square );
+	RenderMinus( drawList, square );
 }
-void RenderHelpers::RenderMenuList( SDL_Renderer* renderer, const MenuList &menuList, const SDL_Rect &screenSize )
+void RenderHelpers::RenderMenuList( DrawList &drawList, const MenuList &menuList, const SDL_Rect &screenSize )
 {
-	RenderTextItem( renderer, menuList.GetMainArea() );
-	RenderTextItem( renderer, menuList.GetCaption() );
+	RenderTextItem( drawList, menuList.GetMainArea() );
+	RenderTextItem( drawList, menuList.GetCaption() );
 
-	RenderScrollBar( renderer, menuList ); 
-	RenderMenuListItems( renderer, menuList, screenSize ); 
+	RenderScrollBar( drawList, menuList ); 
+	RenderMenuListItems( drawList, menuList, screenSize ); 
 }
-void RenderHelpers::RenderConfigList   ( SDL_Renderer* renderer, const ConfigList &menuList, const SDL_Rect &screenSize )
+void RenderHelpers::RenderConfigList   ( DrawList &drawList, const ConfigList &menuList, const SDL_Rect &screenSize, const GlyphAtlas &valueAtlas, const SDL_Color &valueColor )
 {
-	RenderTextItem( renderer, menuList.GetMainArea() );
-	RenderTextItem( renderer, menuList.GetCaption() );
+	RenderTextItem( drawList, menuList.GetMainArea() );
+	RenderTextItem( drawList, menuList.GetCaption() );
 
-	RenderScrollBar( renderer, menuList ); 
-	RenderMenuListItems( renderer, menuList, screenSize ); 
+	RenderScrollBar( drawList, menuList ); 
+	RenderMenuListItems( drawList, menuList, screenSize, valueAtlas, valueColor ); 
 }
-void RenderHelpers::RenderScrollBar    ( SDL_Renderer* renderer, const ConfigList &menuList )
+void RenderHelpers::RenderScrollBar    ( DrawList &drawList, const ConfigList &menuList )
 {
-	SDL_SetRenderDrawColor( renderer, 0,0,255,255 );
+	drawList.SetDrawColor( { 0, 0, 255, 255 } );
 	SDL_Rect r = menuList.GetScrollBar();
-	SDL_RenderFillRect( renderer, &r );
+	drawList.FillRect( r );
 
-	SDL_SetRenderDrawColor( renderer, 0,255,0,255 );
+	drawList.SetDrawColor( { 0, 255, 0, 255 } );
 	r = menuList.GetTopArrow();
-	SDL_RenderFillRect( renderer, &r );
+	drawList.FillRect( r );
 
-	SDL_SetRenderDrawColor( renderer, 255,0,0,255 );
+	drawList.SetDrawColor( { 255, 0, 0, 255 } );
 	r = menuList.GetBottomArrow();
-	SDL_RenderFillRect( renderer, &r);
+	drawList.FillRect( r );
 }
-void RenderHelpers::RenderMenuListItems( SDL_Renderer* renderer, const ConfigList &menuList, const SDL_Rect &screenSize )
+void RenderHelpers::RenderMenuListItems( DrawList &drawList, const ConfigList &menuList, const SDL_Rect &screenSize, const GlyphAtlas &valueAtlas, const SDL_Color &valueColor )
 {
-	SDL_RenderSetClipRect( renderer, menuList.GetListClipRect()  );
+	drawList.SetClipRect( menuList.GetListClipRect() );
 
 	int32_t itemWidth = menuList.GetRect().w - menuList.GetScrollBar().w - 30;
 
 	const auto &configList  = menuList.GetConfigList();
 	for ( const auto &p : configList )
 	{
-		RenderItemBackground( renderer, p.second, itemWidth );
-		RenderConfigItem( renderer, p.second );
+		RenderItemBackground( drawList, p.second, itemWidth );
+		RenderConfigItem( drawList, p.second, valueAtlas, valueColor );
 	}
 
-	SDL_RenderSetClipRect( renderer, &screenSize );
+	drawList.SetClipRect( &screenSize );
 }
-void RenderHelpers::RenderItemBackground( SDL_Renderer* renderer, const std::shared_ptr< ConfigItem > &item, int32_t width )
+void RenderHelpers::RenderItemBackground( DrawList &drawList, const std::shared_ptr< ConfigItem > &item, int32_t width )
 {
 	SDL_Color color = item->GetBackgroundColor();
 	SDL_Rect r;
@@ -265,39 +291,39 @@ void RenderHelpers::RenderItemBackground( SDL_Renderer* renderer, const std::sha
 	r.w = width;
 	r.h = item->GetBottom() - item->GetTop(); 
 
-	SDL_SetRenderDrawColor( renderer, color.r, color.g, color.b, color.a );
-	SDL_RenderFillRect( renderer, &r);
+	drawList.SetDrawColor( color );
+	drawList.FillRect( r );
 }
-void RenderHelpers::RenderScrollBar  ( SDL_Renderer* renderer, const MenuList &menuList )
+void RenderHelpers::RenderScrollBar  ( DrawList &drawList, const MenuList &menuList )
 {
-	SDL_SetRenderDrawColor( renderer, 0,0,255,255 );
+	drawList.SetDrawColor( { 0, 0, 255, 255 } );
 	SDL_Rect r = menuList.GetScrollBar();
-	SDL_RenderFillRect( renderer, &r );
+	drawList.FillRect( r );
 
-	SDL_SetRenderDrawColor( renderer, 0,255,0,255 );
+	drawList.SetDrawColor( { 0, 255, 0, 255 } );
 	r = menuList.GetTopArrow();
-	SDL_RenderFillRect( renderer, &r );
+	drawList.FillRect( r );
 
-	SDL_SetRenderDrawColor( renderer, 255,0,0,255 );
+	drawList.SetDrawColor( { 255, 0, 0, 255 } );
 	r = menuList.GetBottomArrow();
-	SDL_RenderFillRect( renderer, &r);
+	drawList.FillRect( r );
 }
-void RenderHelpers::RenderMenuListItems( SDL_Renderer* renderer, const MenuList &menuList, const SDL_Rect &screenSize )
+void RenderHelpers::RenderMenuListItems( DrawList &drawList, const MenuList &menuList, const SDL_Rect &screenSize )
 {
-	SDL_RenderSetClipRect( renderer, menuList.GetListClipRect()  );
+	drawList.SetClipRect( menuList.GetListClipRect() );
 
 	int32_t itemWidth = menuList.GetRect().w - menuList.GetScrollBar().w - 30;
 
 	const auto &gameList = menuList.GetGameList();
 	for ( const auto &p : gameList )
 	{
-		RenderItemBackground( renderer, p, itemWidth );
-		SDL_RenderCopy( renderer, p.GetTexture(), nullptr, p.GetRectPtr()  );
+		RenderItemBackground( drawList, p, itemWidth );
+		drawList.Copy( p.GetTexture(), nullptr, *p.GetRectPtr() );
 	}
 
-	SDL_RenderSetClipRect( renderer, &screenSize );
+	drawList.SetClipRect( &screenSize );
 }
-void RenderHelpers::RenderItemBackground( SDL_Renderer* renderer, const MenuItem &item, int32_t width )
+void RenderHelpers::RenderItemBackground( DrawList &drawList, const MenuItem &item, int32_t width )
 {
 	SDL_Color color = item.GetBackgroundColor();
 	SDL_Rect r;
@@ -307,22 +333,22 @@ void RenderHelpers::RenderItemBackground( SDL_Renderer* renderer, const MenuItem
 	r.w = width;
 	r.h = item.GetBottom() - item.GetTop(); 
 
-	SDL_SetRenderDrawColor( renderer, color.r, color.g, color.b, color.a );
-	SDL_RenderFillRect( renderer, &r);
+	drawList.SetDrawColor( color );
+	drawList.FillRect( r );
 }
-void RenderHelpers::RenderParticle( SDL_Renderer* renderer, const Particle& particle )
+void RenderHelpers::RenderParticle( DrawList &drawList, const Particle& particle )
 {
 	if ( particle.isAlive )
 	{
 		SDL_Rect r = particle.rect.ToSDLRect();
-		SetDrawColor( renderer, particle.color );
-		SDL_RenderFillRect( renderer, &r );
+		SetDrawColor( drawList, particle.color );
+		drawList.FillRect( r );
 	}
 }
-void RenderHelpers::RenderGamePiece( SDL_Renderer* renderer, const std::shared_ptr< GamePiece > &gamePiece )
+void RenderHelpers::RenderGamePiece( DrawList &drawList, const std::shared_ptr< GamePiece > &gamePiece, const ViewTransform &view )
 {
-	SDL_Rect pieceRect = gamePiece->rect.ToSDLRect();
-	SDL_RenderCopy( renderer, gamePiece->GetTexture(), nullptr, &pieceRect );
+	SDL_Rect pieceRect = view.ToScreen( gamePiece->rect );
+	drawList.Copy( gamePiece->GetTexture(), nullptr, pieceRect );
 }
 void RenderHelpers::SetTileColorSurface( SDL_Renderer* renderer, size_t index, const SDL_Color &color, std::vector< SDL_Texture* > &list  )
 {
@@ -331,17 +357,23 @@ void RenderHelpers::SetTileColorSurface( SDL_Renderer* renderer, size_t index, c
 }
 void RenderHelpers::HideMouseCursor( bool hide)
 {
-	if ( hide )
-		SDL_ShowCursor( SDL_DISABLE );
-	else
-		SDL_ShowCursor( SDL_ENABLE );
+	RenderThread::Invoke( [ hide ]()
+	{
+		if ( hide )
+			SDL_ShowCursor( SDL_DISABLE );
+		else
+			SDL_ShowCursor( SDL_ENABLE );
+	} );
 }
 void RenderHelpers::ForceInputGrab( SDL_Window *window, bool grab )
 {
-	if ( grab )
-		SDL_SetWindowGrab( window, SDL_TRUE );
-	else
-		SDL_SetWindowGrab( window, SDL_FALSE );
+	RenderThread::Invoke( [ window, grab ]()
+	{
+		if ( grab )
+			SDL_SetWindowGrab( window, SDL_TRUE );
+		else
+			SDL_SetWindowGrab( window, SDL_FALSE );
+	} );
 }
 TTF_Font* RenderHelpers::LoadFont( const std::string &name, int size )
 {
@@ -352,50 +384,11 @@ TTF_Font* RenderHelpers::LoadFont( const std::string &name, int size )
 
 	return font;
 }
-SDL_Texture* RenderHelpers::CreateBonusBoxTexture(
-		SDL_Renderer* renderer,
-		SDL_Rect bonusBoxRect,
-		const SDL_Color &outerColor,
-		const SDL_Color &innerColor
-	)
-{
-	// Background
-	SDL_Surface* bonus = SDL_CreateRGBSurface( 0, bonusBoxRect.w, bonusBoxRect.h, SCREEN_BPP, R_MASK, G_MASK, B_MASK, A_MASK);
-
-	uint32_t pixelValue = RenderHelpers::MapRGBA( bonus->format, outerColor );
-	SDL_FillRect( bonus, NULL, pixelValue );
-
-	bonusBoxRect = bonus->clip_rect;
-	SetBonusBoxIcon( bonusBoxRect.w, bonus, innerColor );
-
-	SDL_Texture* bonusBoxTexture = SDL_CreateTextureFromSurface( renderer, bonus );
-
-	SDL_FreeSurface( bonus );
-
-	return bonusBoxTexture;
-}
-void RenderHelpers::SetBonusBoxIcon( int32_t width, SDL_Surface* bonusBox,  const SDL_Color &innerColor  )
-{
-	int32_t bbMargin = width / 8;
-	int32_t doubleMargin = bbMargin * 2;
-
-	SDL_Rect logoPosition;
-	logoPosition.x = bbMargin;
-	logoPosition.y = bbMargin;
-	logoPosition.w = width - doubleMargin;
-	logoPosition.h = width - doubleMargin;
-
-	SDL_Surface* logo = SDL_CreateRGBSurface( 0, logoPosition.w, logoPosition.h, SCREEN_BPP, R_MASK, G_MASK, B_MASK, A_MASK);
-	SDL_FillRect( logo, NULL, SDL_MapRGBA( bonusBox->format, innerColor.r, innerColor.g,  innerColor.b, innerColor.a ) );
-
-	SDL_BlitSurface( logo, NULL, bonusBox, &logoPosition);
-	SDL_FreeSurface( logo );
-}
 SDL_Texture* RenderHelpers::LoadImage( const std::string &filename, SDL_Renderer* renderer )
 {
 	SDL_Surface* loadedImage = IMG_Load( filename.c_str() );
 
-	SDL_Texture* texture = SDL_CreateTextureFromSurface( renderer, loadedImage );
+	SDL_Texture* texture = CreateTexture( renderer, loadedImage );
 
 	SDL_FreeSurface( loadedImage );
 
@@ -13,6 +13,8 @@
 #include <memory>
 
 template < class Value > class RenderingItem;
+class DrawList;
+class GlyphAtlas;
 struct MenuList;
 struct MenuItem;
 struct ConfigItem;
@@ -20,6 +22,7 @@ struct ConfigList;
 struct Particle;
 struct GamePiece;
 struct MainMenuItem;
+class ViewTransform;
 class RenderHelpers
 {
 	public:
@@ -30,6 +33,9 @@ class RenderHelpers
 	static SDL_Texture* InitSurface( const Rect &rect, unsigned char r, unsigned char g, unsigned char b, SDL_Renderer* renderer );
 	static SDL_Texture* InitSurface( int width, int height, unsigned char r, unsigned char g, unsigned char b, SDL_Renderer* renderer  );
 
+	// Empty ( transparent ) 32 bit surface
+	static SDL_Surface* CreateRGBASurface( int width, int height );
+
 	static void FillSurface( SDL_Surface* source, unsigned char r, unsigned char g, unsigned char b );
 	static void FillSurface( SDL_Surface* source, const SDL_Color &color );
 
@@ -54,32 +60,36 @@ class RenderHelpers
 		int style  = 0
 	);
 
-	static SDL_Texture*
-		CreateBonusBoxTexture( SDL_Renderer* renderer, SDL_Rect bonusBoxRect, const SDL_Color &outerColor, const SDL_Color &innerColor );
 	static uint32_t MapRGBA( SDL_PixelFormat* pixelFormat, const SDL_Color &clr );
 	static void SetDrawColor( SDL_Renderer* renderer, const SDL_Color &clr );
+	static void SetDrawColor( DrawList &drawList, const SDL_Color &clr );
+
+	// Textures are created on the render thread ( see RenderThread ), and destroyed once no frame uses them anymore
+	static SDL_Texture* CreateTexture( SDL_Renderer* renderer, SDL_Surface* surface );
+	static void DestroyTexture( SDL_Texture* texture );
 
-	static void RenderTextItem     ( SDL_Renderer* renderer, const RenderingItem< std::string >  &item );
-	static void RenderTextItem     ( SDL_Renderer* renderer, const RenderingItem< uint64_t >  &item );
-	static void RenderMenuItem     ( SDL_Renderer* renderer, const std::shared_ptr< MenuItem > &item );
-	static void RenderConfigItem   ( SDL_Renderer* renderer, const std::shared_ptr< ConfigItem > &item );
+	static void RenderTextItem     ( DrawList &drawList, const RenderingItem< std::string >  &item );
+	static void RenderTextItem     ( DrawList &drawList, const RenderingItem< uint64_t >  &item );
+	static void RenderMenuItem     ( DrawList &drawList, const std::shared_ptr< MenuItem > &item );
+	static void RenderConfigItem   ( DrawList &drawList, const std::shared_ptr< ConfigItem > &item, const GlyphAtlas &valueAtlas, const SDL_Color &valueColor );
 
-	static void RenderMenuList      ( SDL_Renderer* renderer, const MenuList &menuList, const SDL_Rect &screenSize );
-	static void RenderScrollBar     ( SDL_Renderer* renderer, const MenuList &menuList );
-	static void RenderMenuListItems ( SDL_Renderer* renderer, const MenuList &menuList, const SDL_Rect &screenSize );
-	static void RenderItemBackground( SDL_Renderer* renderer, const MenuItem &item, int32_t width );
+	static void RenderMenuList      ( DrawList &drawList, const MenuList &menuList, const SDL_Rect &screenSize );
+	static void RenderScrollBar     ( DrawList &drawList, const MenuList &menuList );
+	static void RenderMenuListItems ( DrawList &drawList, const MenuList &menuList, const SDL_Rect &screenSize );
+	static void RenderItemBackground( DrawList &drawList, const MenuItem &item, int32_t width );
 
-	static void RenderConfigList    ( SDL_Renderer* renderer, const ConfigList &menuList, const SDL_Rect &screenSize );
-	static void RenderScrollBar     ( SDL_Renderer* renderer, const ConfigList &menuList );
-	static void RenderMenuListItems ( SDL_Renderer* renderer, const ConfigList &menuList, const SDL_Rect &screenSize );
-	static void RenderItemBackground( SDL_Renderer* renderer, const std::shared_ptr< ConfigItem > &item, int32_t width );
+	static void RenderConfigList    ( DrawList &drawList, const ConfigList &menuList, const SDL_Rect &screenSize, const GlyphAtlas &valueAtlas, const SDL_Color &valueColor );
+	static void RenderScrollBar     ( DrawList &drawList, const ConfigList &menuList );
+	static void RenderMenuListItems ( DrawList &drawList, const ConfigList &menuList, const SDL_Rect &screenSize, const GlyphAtlas &valueAtlas, const SDL_Color &valueColor );
+	static void RenderItemBackground( DrawList &drawList, const std::shared_ptr< ConfigItem > &item, int32_t width );
 
-	static void RenderParticle   ( SDL_Renderer* renderer, const Particle& particle );
-	static void RenderGamePiece  ( SDL_Renderer* renderer, const std::shared_ptr< GamePiece > &gamePiece );
+	static void RenderParticle   ( DrawList &drawList, const Particle& particle );
+	// The piece is in the field, view puts it on the screen
+	static void RenderGamePiece  ( DrawList &drawList, const std::shared_ptr< GamePiece > &gamePiece, const ViewTransform &view );
 
-	static void RenderPlussMinus ( SDL_Renderer* renderer, SDL_Rect origin );
-	static void RenderMinus      ( SDL_Renderer* renderer, SDL_Rect square );
-	static void RenderPluss      ( SDL_Renderer* renderer, SDL_Rect square );
+	static void RenderPlussMinus ( DrawList &drawList, SDL_Rect origin );
+	static void RenderMinus      ( DrawList &drawList, SDL_Rect square );
+	static void RenderPluss      ( DrawList &drawList, SDL_Rect square );
 
 	static void SetTileColorSurface( SDL_Renderer* renderer, size_t index, const SDL_Color &color, std::vector< SDL_Texture* > &list  );
 	static void HideMouseCursor( bool hide);
@@ -90,8 +100,6 @@ class RenderHelpers
 
 
 	private:
-	static void SetBonusBoxIcon( int32_t width, SDL_Surface* bonusBox,  const SDL_Color &innerColor );
-
 	static const int32_t SCREEN_BPP;
 	static const uint32_t R_MASK;
 	static const uint32_t G_MASK;
@@ -0,0 +1,292 @@
+#include "ReplayPlayer.h"
+
+#include "structs/board/TilePosition.h"
+#include "structs/net/TCPMessageParser.h"
+
+#include "Logger.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <SDL2/SDL.h>
+
+// Has to match ReplayRecorder
+static const char replayMagic[4] = { 'D', 'X', 'B', 'R' };
+static const uint32_t replayVersion = 4;
+
+ReplayPlayer::ReplayPlayer()
+	:	data()
+	,	position( 0 )
+	,	isPlaying( false )
+	,	tickCount( 0 )
+	,	header()
+	,	messageBuffer()
+{
+	logger = Logger::Instance();
+}
+bool ReplayPlayer::Load( const std::string &fileName )
+{
+	std::ifstream file( fileName, std::ios::in | std::ios::binary );
+
+	if ( !file.is_open() )
+	{
+		logger->Log( __FILE__, __LINE__, "Could not open replay file", fileName );
+		return false;
+	}
+
+	data.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+	position = 0;
+	tickCount = 0;
+
+	if ( !ReadHeader() )
+	{
+		logger->Log( __FILE__, __LINE__, "Not a valid replay file", fileName );
+		return false;
+	}
+
+	isPlaying = true;
+	return true;
+}
+bool ReplayPlayer::ReadHeader()
+{
+	if ( data.size() < sizeof( replayMagic ) || memcmp( data.data(), replayMagic, sizeof( replayMagic ) ) != 0 )
+		return false;
+
+	position = sizeof( replayMagic );
+
+	uint32_t version = 0;
+	if ( !Read( version ) || version != replayVersion )
+		return false;
+
+	uint32_t seedLow = 0;
+	uint32_t seedHigh = 0;
+	uint8_t isAIControlled = 0;
+	uint8_t fastMode = 0;
+
+	if ( !Read( seedLow ) || !Read( seedHigh ) || !Read( header.width ) || !Read( header.height ) || !Read( isAIControlled ) || !Read( fastMode ) )
+		return false;
+
+	header.seed = static_cast< uint64_t > ( seedLow ) | ( static_cast< uint64_t > ( seedHigh ) << 32 );
+	header.isAIControlled = isAIControlled != 0;
+	header.fastMode = fastMode != 0;
+
+	uint32_t count = 0;
+	if ( !Read( count ) )
+		return false;
+
+	for ( uint32_t i = 0; i < count; ++i )
+	{
+		int32_t type = 0;
+		double value = 0.0;
+
+		if ( !Read( type ) || !Read( value ) )
+			return false;
+
+		if ( type < 0 || type >= static_cast< int32_t > ( ConfigValueType::Count ) )
+			return false;
+
+		header.configValues[ static_cast< ConfigValueType > ( type ) ] = value;
+	}
+
+	if ( !Read( count ) )
+		return false;
+
+	for ( uint32_t i = 0; i < count; ++i )
+	{
+		int32_t type = 0;
+		int32_t points = 0;
+
+		if ( !Read( type ) || !Read( points ) )
+			return false;
+
+		header.points[ static_cast< TileType > ( type ) ] = points;
+	}
+
+	return true;
+}
+bool ReplayPlayer::IsPlaying() const
+{
+	return isPlaying;
+}
+const ReplayHeader &ReplayPlayer::GetHeader() const
+{
+	return header;
+}
+bool ReplayPlayer::IsNext( ReplayRecordType type ) const
+{
+	if ( position >= data.size() )
+		return false;
+
+	return static_cast< uint8_t > ( data[ position ] ) == static_cast< uint8_t > ( type );
+}
+bool ReplayPlayer::ReadType( ReplayRecordType type )
+{
+	if ( !IsNext( type ) )
+		return false;
+
+	++position;
+	return true;
+}
+bool ReplayPlayer::ReadTick( double &delta, uint32_t &ticks )
+{
+	if ( !ReadType( ReplayRecordType::Tick ) )
+		return false;
+
+	++tickCount;
+	return Read( delta ) && Read( ticks );
+}
+bool ReplayPlayer::ReadEvent( SDL_Event &event )
+{
+	if ( !ReadType( ReplayRecordType::Event ) )
+		return false;
+
+	uint32_t type = 0;
+	int32_t value1 = 0;
+	int32_t value2 = 0;
+
+	if ( !Read( type ) || !Read( value1 ) || !Read( value2 ) )
+		return false;
+
+	// Fills in the same values as ReplayRecorder::RecordEvent stored
+	memset( &event, 0, sizeof( event ) );
+	event.type = type;
+
+	switch ( type )
+	{
+		case SDL_MOUSEMOTION:
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+			event.button.x = value1;
+			event.button.y = value2;
+			break;
+		case SDL_KEYDOWN:
+			event.key.keysym.sym = value1;
+			break;
+		case SDL_JOYBUTTONDOWN:
+		case SDL_JOYBUTTONUP:
+			event.jbutton.state = static_cast< uint8_t > ( value1 );
+			break;
+		default:
+			break;
+	}
+
+	return true;
+}
+bool ReplayPlayer::ReadJoystick( int8_t &direction )
+{
+	uint8_t value = 0;
+
+	if ( !ReadType( ReplayRecordType::Joystick ) || !Read( value ) )
+		return false;
+
+	direction = static_cast< int8_t > ( value );
+	return true;
+}
+bool ReplayPlayer::ReadNetState( uint8_t &state )
+{
+	return ReadType( ReplayRecordType::NetState ) && Read( state );
+}
+bool ReplayPlayer::ReadBoard( std::string &levelName, std::vector< TilePosition > &tiles )
+{
+	uint32_t count = 0;
+
+	if ( !ReadType( ReplayRecordType::Board ) || !Read( levelName ) || !Read( count ) )
+		return false;
+
+	tiles.clear();
+
+	for ( uint32_t i = 0; i < count; ++i )
+	{
+		int32_t type = 0;
+		double x = 0.0;
+		double y = 0.0;
+
+		if ( !Read( type ) || !Read( x ) || !Read( y ) )
+			return false;
+
+		tiles.push_back( TilePosition( x, y, static_cast< TileType > ( type ) ) );
+	}
+
+	return true;
+}
+bool ReplayPlayer::ReadChecksum( uint32_t &checksum )
+{
+	return ReadType( ReplayRecordType::Checksum ) && Read( checksum );
+}
+bool ReplayPlayer::ReadMessage( TCPMessageParser &parser )
+{
+	if ( !ReadType( ReplayRecordType::Message ) || !Read( messageBuffer ) )
+		return false;
+
+	parser.SetBuffer( messageBuffer.c_str(), messageBuffer.size() );
+	return true;
+}
+uint64_t ReplayPlayer::GetTickCount() const
+{
+	return tickCount;
+}
+// Little endian, see ReplayRecorder
+bool ReplayPlayer::Read( uint8_t &value )
+{
+	if ( position >= data.size() )
+		return false;
+
+	value = static_cast< uint8_t > ( data[ position++ ] );
+	return true;
+}
+bool ReplayPlayer::Read( uint16_t &value )
+{
+	uint8_t low = 0;
+	uint8_t high = 0;
+
+	if ( !Read( low ) || !Read( high ) )
+		return false;
+
+	value = static_cast< uint16_t > ( low | ( high << 8 ) );
+	return true;
+}
+bool ReplayPlayer::Read( uint32_t &value )
+{
+	uint16_t low = 0;
+	uint16_t high = 0;
+
+	if ( !Read( low ) || !Read( high ) )
+		return false;
+
+	value = static_cast< uint32_t > ( low ) | ( static_cast< uint32_t > ( high ) << 16 );
+	return true;
+}
+bool ReplayPlayer::Read( int32_t &value )
+{
+	uint32_t bits = 0;
+
+	if ( !Read( bits ) )
+		return false;
+
+	value = static_cast< int32_t > ( bits );
+	return true;
+}
+bool ReplayPlayer::Read( double &value )
+{
+	uint32_t low = 0;
+	uint32_t high = 0;
+
+	if ( !Read( low ) || !Read( high ) )
+		return false;
+
+	uint64_t bits = static_cast< uint64_t > ( low ) | ( static_cast< uint64_t > ( high ) << 32 );
+	memcpy( &value, &bits, sizeof( value ) );
+	return true;
+}
+bool ReplayPlayer::Read( std::string &str )
+{
+	uint16_t length = 0;
+
+	if ( !Read( length ) || ( position + length ) > data.size() )
+		return false;
+
+	str.assign( data.begin() + static_cast< std::ptrdiff_t > ( position ), data.begin() + static_cast< std::ptrdiff_t > ( position + length ) );
+	position += length;
+	return true;
+}
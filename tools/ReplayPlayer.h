@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "enums/ReplayRecordType.h"
+#include "structs/ReplayHeader.h"
+
+union SDL_Event;
+class Logger;
+class TCPMessageParser;
+struct TilePosition;
+
+// Reads replay files written by ReplayRecorder
+// GameManager reads the records in the same order as they were recorded. If the next record isn't what the game expects, the replay has desynced
+class ReplayPlayer
+{
+	public:
+		ReplayPlayer();
+
+		// Reads the whole file and its header
+		bool Load( const std::string &fileName );
+
+		bool IsPlaying() const;
+		const ReplayHeader &GetHeader() const;
+
+		bool IsNext( ReplayRecordType type ) const;
+
+		// All of these return false if the next record is of another type
+		bool ReadTick( double &delta, uint32_t &ticks );
+		bool ReadEvent( SDL_Event &event );
+		bool ReadJoystick( int8_t &direction );
+		bool ReadNetState( uint8_t &state );
+		bool ReadBoard( std::string &levelName, std::vector< TilePosition > &tiles );
+		bool ReadChecksum( uint32_t &checksum );
+
+		// Points the parser to the recorded message. It stays valid until the next record is read
+		bool ReadMessage( TCPMessageParser &parser );
+
+		uint64_t GetTickCount() const;
+
+	private:
+		bool ReadHeader();
+		bool ReadType( ReplayRecordType type );
+
+		bool Read( uint8_t &value );
+		bool Read( uint16_t &value );
+		bool Read( uint32_t &value );
+		bool Read( int32_t &value );
+		bool Read( double &value );
+		bool Read( std::string &str );
+
+		std::vector< char > data;
+		size_t position;
+
+		bool isPlaying;
+		uint64_t tickCount;
+
+		ReplayHeader header;
+		std::string messageBuffer;
+
+		Logger *logger;
+};
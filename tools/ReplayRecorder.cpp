@@ -0,0 +1,286 @@
+#include "ReplayRecorder.h"
+
+#include "structs/ReplayHeader.h"
+#include "structs/board/TilePosition.h"
+#include "structs/net/TCPMessage.h"
+
+#include "Logger.h"
+
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+#include <SDL2/SDL.h>
+
+// Has to match ReplayPlayer
+static const char replayMagic[4] = { 'D', 'X', 'B', 'R' };
+static const uint32_t replayVersion = 4;
+
+ReplayRecorder::ReplayRecorder()
+	:	isRecording( false )
+	,	file()
+	,	frameBuffer()
+	,	messageStream()
+	,	pendingBuffer()
+	,	stopWriter( false )
+	,	bufferMutex()
+	,	bufferReady()
+	,	writer()
+{
+	logger = Logger::Instance();
+
+	// Doubles are written with full precision, so that the replayed message is exactly the one that was recieved
+	messageStream.precision( std::numeric_limits< double >::max_digits10 );
+}
+ReplayRecorder::~ReplayRecorder()
+{
+	Stop();
+}
+bool ReplayRecorder::Start( const std::string &fileName, const ReplayHeader &header )
+{
+	Stop();
+
+	file.open( fileName, std::ios::out | std::ios::binary | std::ios::trunc );
+
+	if ( !file.is_open() )
+	{
+		logger->Log( __FILE__, __LINE__, "Could not open replay file", fileName );
+		return false;
+	}
+
+	frameBuffer.clear();
+	frameBuffer.insert( frameBuffer.end(), replayMagic, replayMagic + sizeof( replayMagic ) );
+
+	WriteUInt32( replayVersion );
+	WriteUInt32( static_cast< uint32_t > ( header.seed & 0xFFFFFFFF ) );
+	WriteUInt32( static_cast< uint32_t > ( header.seed >> 32 ) );
+	WriteInt32( header.width );
+	WriteInt32( header.height );
+	WriteUInt8( header.isAIControlled ? 1 : 0 );
+	WriteUInt8( header.fastMode ? 1 : 0 );
+
+	WriteUInt32( static_cast< uint32_t > ( header.configValues.size() ) );
+	for ( const auto &p : header.configValues )
+	{
+		WriteInt32( static_cast< int32_t > ( p.first ) );
+		WriteDouble( p.second );
+	}
+
+	WriteUInt32( static_cast< uint32_t > ( header.points.size() ) );
+	for ( const auto &p : header.points )
+	{
+		WriteInt32( static_cast< int32_t > ( p.first ) );
+		WriteInt32( p.second );
+	}
+
+	// The header is written right away, everything after it goes through the writer thread
+	file.write( frameBuffer.data(), static_cast< std::streamsize > ( frameBuffer.size() ) );
+	frameBuffer.clear();
+
+	stopWriter = false;
+	writer = std::thread( &ReplayRecorder::WriteLoop, this );
+	isRecording = true;
+
+	logger->Log( __FILE__, __LINE__, "Recording replay to", fileName );
+	return true;
+}
+void ReplayRecorder::Stop()
+{
+	if ( !isRecording )
+		return;
+
+	WriteType( ReplayRecordType::End );
+	EndTick();
+
+	{
+		std::lock_guard< std::mutex > lock( bufferMutex );
+		stopWriter = true;
+	}
+	bufferReady.notify_one();
+
+	writer.join();
+	file.close();
+
+	isRecording = false;
+}
+bool ReplayRecorder::IsRecording() const
+{
+	return isRecording;
+}
+void ReplayRecorder::RecordTick( double delta, uint32_t ticks )
+{
+	if ( !isRecording )
+		return;
+
+	WriteType( ReplayRecordType::Tick );
+	WriteDouble( delta );
+	WriteUInt32( ticks );
+}
+void ReplayRecorder::RecordEvent( const SDL_Event &event )
+{
+	if ( !isRecording )
+		return;
+
+	// Only the events GameManager::HandleEvent cares about, with only the values it uses
+	int32_t value1 = 0;
+	int32_t value2 = 0;
+
+	switch ( event.type )
+	{
+		case SDL_MOUSEMOTION:
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+			value1 = event.button.x;
+			value2 = event.button.y;
+			break;
+		case SDL_KEYDOWN:
+			value1 = event.key.keysym.sym;
+			break;
+		case SDL_JOYBUTTONDOWN:
+		case SDL_JOYBUTTONUP:
+			value1 = event.jbutton.state;
+			break;
+		case SDL_QUIT:
+			break;
+		default:
+			return;
+	}
+
+	WriteType( ReplayRecordType::Event );
+	WriteUInt32( event.type );
+	WriteInt32( value1 );
+	WriteInt32( value2 );
+}
+void ReplayRecorder::RecordJoystick( int8_t direction )
+{
+	if ( !isRecording )
+		return;
+
+	WriteType( ReplayRecordType::Joystick );
+	WriteUInt8( static_cast< uint8_t > ( direction ) );
+}
+void ReplayRecorder::RecordNetState( uint8_t state )
+{
+	if ( !isRecording )
+		return;
+
+	WriteType( ReplayRecordType::NetState );
+	WriteUInt8( state );
+}
+void ReplayRecorder::RecordMessage( const TCPMessage &message )
+{
+	if ( !isRecording )
+		return;
+
+	// Stored the same way it's sent, so that ReplayPlayer can use TCPMessageParser
+	messageStream.str( "" );
+	messageStream << message;
+
+	WriteType( ReplayRecordType::Message );
+	WriteString( messageStream.str() );
+}
+void ReplayRecorder::RecordBoard( const std::string &levelName, const std::vector< TilePosition > &tiles )
+{
+	if ( !isRecording )
+		return;
+
+	WriteType( ReplayRecordType::Board );
+	WriteString( levelName );
+	WriteUInt32( static_cast< uint32_t > ( tiles.size() ) );
+
+	for ( const auto &tile : tiles )
+	{
+		WriteInt32( static_cast< int32_t > ( tile.type ) );
+		WriteDouble( tile.tilePos.x );
+		WriteDouble( tile.tilePos.y );
+	}
+}
+void ReplayRecorder::RecordChecksum( uint32_t checksum )
+{
+	if ( !isRecording )
+		return;
+
+	WriteType( ReplayRecordType::Checksum );
+	WriteUInt32( checksum );
+}
+void ReplayRecorder::EndTick()
+{
+	if ( !isRecording || frameBuffer.empty() )
+		return;
+
+	{
+		std::lock_guard< std::mutex > lock( bufferMutex );
+		pendingBuffer.insert( pendingBuffer.end(), frameBuffer.begin(), frameBuffer.end() );
+	}
+	bufferReady.notify_one();
+
+	// clear() keeps the capacity, so this doesn't allocate after the first few frames
+	frameBuffer.clear();
+}
+void ReplayRecorder::WriteLoop()
+{
+	std::vector< char > writeBuffer;
+
+	while ( true )
+	{
+		bool stop = false;
+
+		{
+			std::unique_lock< std::mutex > lock( bufferMutex );
+			bufferReady.wait( lock, [ this ](){ return stopWriter || !pendingBuffer.empty(); } );
+
+			// Swapping means the game thread gets back an empty buffer that has already been allocated
+			writeBuffer.swap( pendingBuffer );
+			stop = stopWriter;
+		}
+
+		if ( !writeBuffer.empty() )
+		{
+			file.write( writeBuffer.data(), static_cast< std::streamsize > ( writeBuffer.size() ) );
+			writeBuffer.clear();
+		}
+
+		if ( stop )
+			break;
+	}
+
+	file.flush();
+}
+// Everything is written little endian, so that replays can be moved between machines
+void ReplayRecorder::WriteType( ReplayRecordType type )
+{
+	WriteUInt8( static_cast< uint8_t > ( type ) );
+}
+void ReplayRecorder::WriteUInt8( uint8_t value )
+{
+	frameBuffer.push_back( static_cast< char > ( value ) );
+}
+void ReplayRecorder::WriteUInt16( uint16_t value )
+{
+	WriteUInt8( static_cast< uint8_t > ( value & 0xFF ) );
+	WriteUInt8( static_cast< uint8_t > ( value >> 8 ) );
+}
+void ReplayRecorder::WriteUInt32( uint32_t value )
+{
+	WriteUInt16( static_cast< uint16_t > ( value & 0xFFFF ) );
+	WriteUInt16( static_cast< uint16_t > ( value >> 16 ) );
+}
+void ReplayRecorder::WriteInt32( int32_t value )
+{
+	WriteUInt32( static_cast< uint32_t > ( value ) );
+}
+void ReplayRecorder::WriteDouble( double value )
+{
+	uint64_t bits = 0;
+	memcpy( &bits, &value, sizeof( bits ) );
+
+	WriteUInt32( static_cast< uint32_t > ( bits & 0xFFFFFFFF ) );
+	WriteUInt32( static_cast< uint32_t > ( bits >> 32 ) );
+}
+void ReplayRecorder::WriteString( const std::string &str )
+{
+	uint16_t length = static_cast< uint16_t > ( std::min< size_t > ( str.size(), 0xFFFF ) );
+
+	WriteUInt16( length );
+	frameBuffer.insert( frameBuffer.end(), str.begin(), str.begin() + length );
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+#include <condition_variable>
+
+#include "enums/ReplayRecordType.h"
+
+union SDL_Event;
+class Logger;
+class TCPMessage;
+struct ReplayHeader;
+struct TilePosition;
+
+// Writes everything the game can't reproduce on its own to a binary replay file ( see ReplayPlayer )
+// The game thread only appends to a buffer, the file is written by a separate thread so that recording doesn't slow down the frames
+class ReplayRecorder
+{
+	public:
+		ReplayRecorder();
+		~ReplayRecorder();
+
+		bool Start( const std::string &fileName, const ReplayHeader &header );
+		void Stop();
+		bool IsRecording() const;
+
+		void RecordTick( double delta, uint32_t ticks );
+		void RecordEvent( const SDL_Event &event );
+		void RecordJoystick( int8_t direction );
+		void RecordNetState( uint8_t state );
+		void RecordMessage( const TCPMessage &message );
+		void RecordBoard( const std::string &levelName, const std::vector< TilePosition > &tiles );
+		void RecordChecksum( uint32_t checksum );
+
+		// Hands everything recorded this frame over to the writer thread
+		void EndTick();
+
+	private:
+		void WriteLoop();
+
+		void WriteType( ReplayRecordType type );
+		void WriteUInt8( uint8_t value );
+		void WriteUInt16( uint16_t value );
+		void WriteUInt32( uint32_t value );
+		void WriteInt32( int32_t value );
+		void WriteDouble( double value );
+		void WriteString( const std::string &str );
+
+		bool isRecording;
+		std::ofstream file;
+
+		// Only used by the game thread
+		std::vector< char > frameBuffer;
+		std::stringstream messageStream;
+
+		// Shared with the writer thread
+		std::vector< char > pendingBuffer;
+		bool stopWriter;
+		std::mutex bufferMutex;
+		std::condition_variable bufferReady;
+
+		std::thread writer;
+
+		Logger *logger;
+
+		ReplayRecorder( const ReplayRecorder &other );
+		ReplayRecorder& operator=( const ReplayRecorder &other );
+};
@@ -22,6 +22,14 @@ inline std::istream& operator>>( std::istream &is, SDL_Color &color )
 
 	return is;
 }
+inline bool operator==( const SDL_Color &color1, const SDL_Color &color2 )
+{
+	return color1.r == color2.r && color1.g == color2.g && color1.b == color2.b && color1.a == color2.a;
+}
+inline bool operator!=( const SDL_Color &color1, const SDL_Color &color2 )
+{
+	return !( color1 == color2 );
+}
 inline std::ostream& operator<<( std::ostream &os, const SDL_Color &color )
 {
 	os
@@ -0,0 +1,150 @@
+#include "SimulationFarm.h"
+
+#include "WorkStealingPool.h"
+
+#include "math/RandomService.h"
+
+#include "BoardLoader.h"
+#include "Logger.h"
+
+#include <chrono>
+#include <numeric>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+SimulationFarm::SimulationFarm( uint32_t threadCount_ )
+	:	settings()
+	,	config()
+	,	levels()
+	,	threadCount( threadCount_ )
+{
+}
+bool SimulationFarm::Run( uint32_t matchCount, uint64_t seed )
+{
+	config.LoadConfig();
+	LoadBoards();
+
+	if ( levels.empty() )
+	{
+		std::cout << "No boards to play, check boards/boardlist.txt" << std::endl;
+		return false;
+	}
+
+	std::vector< MatchResult > results( matchCount );
+	WorkStealingPool pool( threadCount );
+
+	std::cout << "Simulating " << matchCount << " matches on " << pool.GetThreadCount() << " threads, seed : " << seed << std::endl;
+
+	// Each task only writes to its own result
+	for ( uint32_t i = 0; i < matchCount; ++i )
+	{
+		MatchResult* result = &results[ i ];
+		uint64_t matchSeed = seed + i;
+
+		pool.Add( [ this, result, matchSeed ](){ *result = RunMatch( matchSeed ); } );
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	pool.Run();
+	std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+
+	PrintReport( results, elapsed.count(), pool.GetThreadCount() );
+	return true;
+}
+void SimulationFarm::LoadBoards()
+{
+	// Loaded once and shared by all matches, instead of every match reading the files again
+	BoardLoader boardLoader;
+	levels.clear();
+
+	while ( !boardLoader.IsLastLevel() )
+		levels.push_back( boardLoader.GenerateBoard( settings.windowSize ).GetTiles() );
+}
+MatchResult SimulationFarm::RunMatch( uint64_t seed ) const
+{
+	// Everything the match creates picks these up, so nothing mutable is shared with the other threads
+	Logger logger( false, false );
+	RandomService random( seed );
+
+	Logger::SetCurrent( &logger );
+	RandomService::SetCurrent( &random );
+
+	MatchResult result;
+	{
+		SimulationMatch match( settings, config, levels );
+		result = match.Run();
+	}
+	result.seed = seed;
+
+	Logger::SetCurrent( nullptr );
+	RandomService::SetCurrent( nullptr );
+
+	return result;
+}
+void SimulationFarm::PrintReport( const std::vector< MatchResult > &results, double seconds, uint32_t threads ) const
+{
+	std::vector< uint32_t > points;
+	std::vector< double > levelDurations;
+	double gameSeconds = 0.0;
+	uint64_t ticks = 0;
+	uint32_t timedOut = 0;
+
+	for ( const auto &result : results )
+	{
+		points.push_back( result.localPoints );
+		points.push_back( result.remotePoints );
+		levelDurations.insert( levelDurations.end(), result.levelDurations.begin(), result.levelDurations.end() );
+
+		gameSeconds += result.seconds;
+		ticks += result.ticks;
+
+		if ( result.timedOut )
+			++timedOut;
+	}
+
+	std::sort( points.begin(), points.end() );
+	std::sort( levelDurations.begin(), levelDurations.end() );
+
+	auto percentile = [ &points ]( double p )
+	{
+		if ( points.empty() )
+			return 0u;
+
+		return points[ static_cast< size_t > ( p * static_cast< double > ( points.size() - 1 ) ) ];
+	};
+
+	double matches = static_cast< double > ( results.size() );
+	double perSecond = ( seconds > 0.0 ) ? ( matches / seconds ) : 0.0;
+	double averageLevel = levelDurations.empty() ? 0.0 :
+		std::accumulate( levelDurations.begin(), levelDurations.end(), 0.0 ) / static_cast< double > ( levelDurations.size() );
+	double averagePoints = points.empty() ? 0.0 :
+		static_cast< double > ( std::accumulate( points.begin(), points.end(), uint64_t( 0 ) ) ) / static_cast< double > ( points.size() );
+
+	std::cout << std::fixed << std::setprecision( 2 );
+	std::cout << "========== SIMULATION ==========\n";
+	std::cout << "Matches          : " << results.size() << " ( " << timedOut << " timed out )" << std::endl;
+	std::cout << "Threads          : " << threads << std::endl;
+	std::cout << "Seconds          : " << seconds << std::endl;
+	std::cout << "Games / second   : " << perSecond << std::endl;
+	std::cout << "Ticks / second   : " << ( ( seconds > 0.0 ) ? ( static_cast< double > ( ticks ) / seconds ) : 0.0 ) << std::endl;
+	std::cout << "Game time        : " << gameSeconds << "s, " << ( ( seconds > 0.0 ) ? ( gameSeconds / seconds ) : 0.0 ) << "x real time" << std::endl;
+	std::cout << "Levels completed : " << levelDurations.size() << std::endl;
+
+	if ( !levelDurations.empty() )
+	{
+		std::cout << "Level duration   : avg " << averageLevel << "s"
+			<< " | min " << levelDurations.front() << "s"
+			<< " | max " << levelDurations.back() << "s" << std::endl;
+	}
+
+	std::cout << "Points / player  : avg " << averagePoints
+		<< " | min " << percentile( 0.0 )
+		<< " | p25 " << percentile( 0.25 )
+		<< " | median " << percentile( 0.5 )
+		<< " | p75 " << percentile( 0.75 )
+		<< " | p90 " << percentile( 0.9 )
+		<< " | max " << percentile( 1.0 ) << std::endl;
+	std::cout << "================================\n";
+	std::cout << std::defaultfloat << std::setprecision( 6 );
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "SimulationMatch.h"
+
+#include "structs/board/TilePosition.h"
+
+#include "ConfigLoader.h"
+
+// Plays lots of headless matches ( see SimulationMatch ) at once, for balancing and soak testing. Started with the -simulate command line option
+// Every match runs start to finish on one thread with its own Logger and RandomService, the only thing they share is the config and the boards, which are read only
+class SimulationFarm
+{
+	public:
+		SimulationFarm( uint32_t threadCount_ );
+
+		// Match i is seeded with seed + i, so any single match can be played again
+		bool Run( uint32_t matchCount, uint64_t seed );
+
+	private:
+		void LoadBoards();
+		MatchResult RunMatch( uint64_t seed ) const;
+		void PrintReport( const std::vector< MatchResult > &results, double seconds, uint32_t threads ) const;
+
+		SimulationSettings settings;
+		ConfigLoader config;
+		std::vector< std::vector< TilePosition > > levels;
+		uint32_t threadCount;
+};
@@ -0,0 +1,141 @@
+#include "SimulationMatch.h"
+
+#include "structs/game_objects/Ball.h"
+#include "structs/game_objects/Tile.h"
+#include "structs/game_objects/Paddle.h"
+
+#include "enums/Player.h"
+#include "enums/ConfigValueType.h"
+
+#include <algorithm>
+
+SimulationMatch::SimulationMatch( const SimulationSettings &settings_, const ConfigLoader &config_, const std::vector< std::vector< TilePosition > > &levels_ )
+	:	settings( settings_ )
+	,	config( config_ )
+	,	levels( levels_ )
+	,	netManager()
+	,	messageSender( netManager )
+	,	physicsManager( messageSender )
+	,	localPaddle( std::make_shared< Paddle > () )
+	,	remotePaddle( std::make_shared< Paddle > () )
+	,	ballList()
+	,	tileList()
+	,	deadPieces()
+	,	localPlayerInfo()
+	,	remotePlayerInfo()
+	,	gameRules( physicsManager, config, localPlayerInfo, remotePlayerInfo )
+	,	ballCount( 0 )
+	,	currentLevel( 0 )
+	,	levelStart( 0.0 )
+	,	result()
+{
+	physicsManager.SetWindowSize( settings.windowSize );
+	physicsManager.SetPaddles( localPaddle, remotePaddle );
+	physicsManager.SetPaddleData();
+	physicsManager.SetBulletSpeed( config.Get( ConfigValueType::BulletSpeed ) );
+	physicsManager.SetBonusBoxSpeed( config.Get( ConfigValueType::BonusBoxSpeed ) );
+	physicsManager.SetAIPaddleSpeed( config.Get( ConfigValueType::AIPaddleSpeed ) );
+
+	gameRules.SetWindowSize( settings.windowSize );
+	gameRules.SetPaddles( localPaddle, remotePaddle );
+	gameRules.SetPlaysBothPlayers( true );
+
+	localPlayerInfo.Reset();
+	remotePlayerInfo.Reset();
+
+	localPlayerInfo.ballSpeed = config.Get( ConfigValueType::BallSpeed );
+	remotePlayerInfo.ballSpeed = config.Get( ConfigValueType::BallSpeed );
+}
+MatchResult SimulationMatch::Run()
+{
+	if ( !StartLevel() )
+		return result;
+
+	while ( !gameRules.IsGameOver() )
+	{
+		if ( result.seconds >= settings.maxSeconds )
+		{
+			result.timedOut = true;
+			break;
+		}
+
+		ServeBalls();
+
+		physicsManager.AIMove( Player::Local, settings.tickLength );
+		physicsManager.AIMove( Player::Remote, settings.tickLength );
+
+		gameRules.UpdateBalls( ballList, settings.tickLength );
+
+		RemoveDeadPieces();
+
+		result.seconds += settings.tickLength;
+		++result.ticks;
+
+		if ( gameRules.IsLevelDone() )
+		{
+			result.levelDurations.push_back( result.seconds - levelStart );
+			++result.levelsCompleted;
+
+			if ( !StartLevel() )
+				break;
+		}
+	}
+
+	result.localPoints = localPlayerInfo.points;
+	result.remotePoints = remotePlayerInfo.points;
+
+	return result;
+}
+bool SimulationMatch::StartLevel()
+{
+	if ( currentLevel == levels.size() )
+		return false;
+
+	physicsManager.Clear();
+	tileList.clear();
+
+	for ( const auto &tile : levels[ currentLevel ] )
+		tileList.push_back( physicsManager.CreateTile( tile.tilePos, tile.type, -1 ) );
+
+	physicsManager.UpdateScale();
+
+	++currentLevel;
+	levelStart = result.seconds;
+
+	// Same as the player clicking to start the next level
+	for ( const auto &ball : ballList )
+	{
+		ball->Reset( settings.windowSize );
+		ball->SetSpeed( gameRules.GetPlayerInfo( ball->GetOwner() ).ballSpeed );
+	}
+
+	return true;
+}
+void SimulationMatch::ServeBalls()
+{
+	// The AI serves right away
+	if ( localPlayerInfo.CanSpawnNewBall() )
+		SpawnBall( Player::Local );
+
+	if ( remotePlayerInfo.CanSpawnNewBall() )
+		SpawnBall( Player::Remote );
+}
+void SimulationMatch::SpawnBall( const Player &owner )
+{
+	PlayerInfo &info = gameRules.GetPlayerInfo( owner );
+	++info.activeBalls;
+
+	ballList.push_back( physicsManager.CreateBall( owner, ++ballCount, info.ballSpeed ) );
+}
+void SimulationMatch::RemoveDeadPieces()
+{
+	if ( !gameRules.TakeDeadPieces( deadPieces ) )
+		return;
+
+	physicsManager.RemoveDeadPieces( deadPieces );
+
+	Graveyard::Compact( ballList );
+	Graveyard::Compact( tileList );
+
+	deadPieces.Clear();
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "enums/BonusType.h"
+#include "structs/PlayerInfo.h"
+#include "structs/board/TilePosition.h"
+
+#include "GameRules.h"
+#include "ConfigLoader.h"
+#include "NetManager.h"
+#include "MessageSender.h"
+#include "PhysicsManager.h"
+
+#include "math/ViewTransform.h"
+
+#include <SDL2/SDL.h>
+
+struct Ball;
+struct Tile;
+struct Paddle;
+enum class Player : int;
+
+struct SimulationSettings
+{
+	SimulationSettings()
+		:	windowSize( ViewTransform::GetField() )
+		,	tickLength( 0.01 )
+		,	maxSeconds( 7200.0 )
+	{
+	}
+	// The field, the same as in a real game no matter the resolution
+	SDL_Rect windowSize;
+
+	// Game time, in seconds
+	double tickLength;
+	double maxSeconds;
+};
+
+struct MatchResult
+{
+	MatchResult()
+		:	seed( 0 )
+		,	localPoints( 0 )
+		,	remotePoints( 0 )
+		,	levelsCompleted( 0 )
+		,	levelDurations()
+		,	seconds( 0.0 )
+		,	ticks( 0 )
+		,	timedOut( false )
+	{
+	}
+	uint64_t seed;
+	uint32_t localPoints;
+	uint32_t remotePoints;
+	uint32_t levelsCompleted;
+	std::vector< double > levelDurations;
+	double seconds;
+	uint64_t ticks;
+	bool timedOut;
+};
+
+// One headless game with the AI controlling both paddles ( see SimulationFarm )
+// Has its own PhysicsManager, board and players, and plays by the same GameRules as GameManager. Nothing is rendered or sent over the network
+// Bonus boxes, bullets and fast mode are left out, it's the tiles, balls and lives that decide how long a level takes
+// Logger::Instance() and RandomService::Current() must point to the match' own ones before it's created
+class SimulationMatch
+{
+	public:
+		SimulationMatch( const SimulationSettings &settings_, const ConfigLoader &config_, const std::vector< std::vector< TilePosition > > &levels_ );
+
+		MatchResult Run();
+
+	private:
+		// Returns false when there are no more levels
+		bool StartLevel();
+		void ServeBalls();
+		void SpawnBall( const Player &owner );
+
+		// Like GameManager::RemoveDeadPieces
+		void RemoveDeadPieces();
+
+		const SimulationSettings &settings;
+		ConfigLoader config;
+		const std::vector< std::vector< TilePosition > > &levels;
+
+		// PhysicsManager needs a MessageSender, this one never connects anywhere
+		NetManager netManager;
+		MessageSender messageSender;
+		PhysicsManager physicsManager;
+
+		std::shared_ptr< Paddle > localPaddle;
+		std::shared_ptr< Paddle > remotePaddle;
+
+		std::vector< std::shared_ptr< Ball > > ballList;
+		std::vector< std::shared_ptr< Tile > > tileList;
+
+		DeadPieces deadPieces;
+
+		PlayerInfo localPlayerInfo;
+		PlayerInfo remotePlayerInfo;
+
+		GameRules gameRules;
+
+		uint32_t ballCount;
+		size_t currentLevel;
+		double levelStart;
+
+		MatchResult result;
+
+		SimulationMatch( const SimulationMatch &other );
+		SimulationMatch& operator=( const SimulationMatch &other );
+};
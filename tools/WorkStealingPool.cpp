@@ -0,0 +1,78 @@
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool( uint32_t threadCount )
+	:	queues()
+	,	nextQueue( 0 )
+{
+	if ( threadCount == 0 )
+		threadCount = std::thread::hardware_concurrency();
+
+	if ( threadCount == 0 )
+		threadCount = 1;
+
+	for ( uint32_t i = 0; i < threadCount; ++i )
+		queues.push_back( std::unique_ptr< WorkQueue >( new WorkQueue() ) );
+}
+void WorkStealingPool::Add( const Task &task )
+{
+	// Spread out round robin, stealing evens out the rest
+	WorkQueue &queue = *queues[ nextQueue ];
+	nextQueue = ( nextQueue + 1 ) % queues.size();
+
+	std::lock_guard< std::mutex > lock( queue.mutex );
+	queue.tasks.push_back( task );
+}
+void WorkStealingPool::Run()
+{
+	std::vector< std::thread > workers;
+
+	// The calling thread works too, instead of just waiting
+	for ( size_t i = 1; i < queues.size(); ++i )
+		workers.push_back( std::thread( &WorkStealingPool::WorkLoop, this, i ) );
+
+	WorkLoop( 0 );
+
+	for ( auto &worker : workers )
+		worker.join();
+}
+uint32_t WorkStealingPool::GetThreadCount() const
+{
+	return static_cast< uint32_t > ( queues.size() );
+}
+void WorkStealingPool::WorkLoop( size_t index )
+{
+	Task task;
+
+	// No task adds new tasks, so once every queue is empty the work is done
+	while ( PopOwn( index, task ) || Steal( index, task ) )
+		task();
+}
+bool WorkStealingPool::PopOwn( size_t index, Task &task )
+{
+	WorkQueue &queue = *queues[ index ];
+	std::lock_guard< std::mutex > lock( queue.mutex );
+
+	if ( queue.tasks.empty() )
+		return false;
+
+	task = queue.tasks.back();
+	queue.tasks.pop_back();
+	return true;
+}
+bool WorkStealingPool::Steal( size_t index, Task &task )
+{
+	for ( size_t i = 1; i < queues.size(); ++i )
+	{
+		WorkQueue &queue = *queues[ ( index + i ) % queues.size() ];
+		std::lock_guard< std::mutex > lock( queue.mutex );
+
+		if ( queue.tasks.empty() )
+			continue;
+
+		task = queue.tasks.front();
+		queue.tasks.pop_front();
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+// Runs a batch of independent tasks on a fixed number of threads
+// Every worker has its own queue and takes tasks from the back of it. When it runs dry, it steals from the front of the other queues
+// so that a worker stuck with a few long tasks doesn't hold up the rest
+class WorkStealingPool
+{
+	public:
+		typedef std::function< void() > Task;
+
+		// 0 threads means one for each core
+		explicit WorkStealingPool( uint32_t threadCount );
+
+		// Has to be called before Run(), tasks can't add new tasks
+		void Add( const Task &task );
+
+		// Starts the workers and returns when every task is done
+		void Run();
+
+		uint32_t GetThreadCount() const;
+
+	private:
+		struct WorkQueue
+		{
+			std::mutex mutex;
+			std::deque< Task > tasks;
+		};
+
+		void WorkLoop( size_t index );
+		bool PopOwn( size_t index, Task &task );
+		bool Steal( size_t index, Task &task );
+
+		std::vector< std::unique_ptr< WorkQueue > > queues;
+		size_t nextQueue;
+};